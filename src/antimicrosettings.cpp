@@ -21,12 +21,27 @@
 #include "messagehandler.h"
 
 #include <QDebug>
+#include <QMutexLocker>
 
 
 AntiMicroSettings::AntiMicroSettings(const QString &fileName, Format format, QObject *parent) :
     QSettings(fileName, format, parent)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    flushQueued = false;
+    refreshSnapshot();
+}
+
+AntiMicroSettings::~AntiMicroSettings()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    flushPendingWrites();
+
+    qDeleteAll(retiredSnapshots);
+    retiredSnapshots.clear();
+    delete currentSnapshot.fetchAndStoreOrdered(nullptr);
 }
 
 /**
@@ -86,3 +101,212 @@ QSettings& AntiMicroSettings::getCmdSettings() {
 
     return cmdSettings;
 }
+
+/**
+ * @brief Get the current snapshot of all stored values. The snapshot is
+ *     never changed after it is published, so it can be read without the
+ *     settings lock while other code writes new values. Does not wait for
+ *     writers of the snapshot either.
+ * @return Snapshot of the stored values
+ */
+QSharedPointer<const AntiMicroSettings::settingsSnapshot> AntiMicroSettings::snapshot() const
+{
+    // Writers only free a replaced snapshot while no reader is counted.
+    // Both steps are ordered operations, so a reader counted after that
+    // check also sees the newer snapshot.
+    activeReaders.ref();
+    QSharedPointer<const settingsSnapshot> values = *currentSnapshot.fetchAndAddOrdered(0);
+    activeReaders.deref();
+
+    return values;
+}
+
+/**
+ * @brief Get a value from the current snapshot. Does not take the settings
+ *     lock and does not touch the settings file.
+ * @param Full setting key, including its group
+ * @param Default value to use if key does not exist
+ * @return Stored value or the default value passed
+ */
+QVariant AntiMicroSettings::snapshotValue(const QString &key, const QVariant &defaultValue) const
+{
+    return snapshot()->value(key, defaultValue);
+}
+
+/**
+ * @brief Rebuild the snapshot from the stored values. Needed after values
+ *     were written with setValue or remove. Must not be called with the
+ *     settings lock held or inside a group.
+ */
+void AntiMicroSettings::refreshSnapshot()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    settingsSnapshot *values = new settingsSnapshot();
+
+    lock.lock();
+
+    QStringListIterator iter(allKeys());
+
+    while (iter.hasNext())
+    {
+        QString key = iter.next();
+        values->insert(key, value(key));
+    }
+
+    snapshotMutex.lock();
+
+    QHashIterator<QString, QVariant> pendingIter(pendingWrites);
+
+    while (pendingIter.hasNext())
+    {
+        pendingIter.next();
+
+        if (pendingIter.value().isValid()) values->insert(pendingIter.key(), pendingIter.value());
+        else values->remove(pendingIter.key());
+    }
+
+    publishSnapshot(values);
+    snapshotMutex.unlock();
+
+    lock.unlock();
+}
+
+/**
+ * @brief Change a value in the snapshot right away and write it to the
+ *     settings later from the thread owning the settings. Changes made
+ *     before the write happens are combined into one write.
+ * @param Full setting key, including its group
+ * @param New value
+ */
+void AntiMicroSettings::setValueDeferred(const QString &key, const QVariant &value)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    QMutexLocker locker(&snapshotMutex);
+
+    settingsSnapshot *values = new settingsSnapshot(currentValues());
+    values->insert(key, value);
+    publishSnapshot(values);
+
+    queueWrite(key, value);
+}
+
+/**
+ * @brief Remove a value from the snapshot right away and from the
+ *     settings later.
+ * @param Full setting key, including its group
+ */
+void AntiMicroSettings::removeDeferred(const QString &key)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    QMutexLocker locker(&snapshotMutex);
+
+    settingsSnapshot *values = new settingsSnapshot(currentValues());
+    values->remove(key);
+    publishSnapshot(values);
+
+    queueWrite(key, QVariant());
+}
+
+/**
+ * @brief Move a value to a new key, such as a setting stored under a GUID
+ *     by older versions. Works like setValueDeferred and removeDeferred.
+ * @param Full key the value is stored under
+ * @param Full key to store the value under
+ * @return Whether a value was moved
+ */
+bool AntiMicroSettings::moveDeferred(const QString &oldKey, const QString &newKey)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    QMutexLocker locker(&snapshotMutex);
+
+    if (!currentValues().contains(oldKey))
+        return false;
+
+    settingsSnapshot *values = new settingsSnapshot(currentValues());
+    QVariant movedValue = values->take(oldKey);
+    values->insert(newKey, movedValue);
+    publishSnapshot(values);
+
+    queueWrite(newKey, movedValue);
+    queueWrite(oldKey, QVariant());
+
+    return true;
+}
+
+/**
+ * @brief Write deferred changes to the settings. QSettings stores them in
+ *     the file on its next sync.
+ */
+void AntiMicroSettings::flushPendingWrites()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    lock.lock();
+
+    snapshotMutex.lock();
+    QHash<QString, QVariant> writes = pendingWrites;
+    pendingWrites.clear();
+    flushQueued = false;
+    snapshotMutex.unlock();
+
+    QHashIterator<QString, QVariant> iter(writes);
+
+    while (iter.hasNext())
+    {
+        iter.next();
+
+        if (iter.value().isValid()) setValue(iter.key(), iter.value());
+        else remove(iter.key());
+    }
+
+    lock.unlock();
+}
+
+/**
+ * @brief Replace the current snapshot. Called with the snapshot mutex held.
+ *     Readers still holding the old snapshot keep it until they let go.
+ *     The shared pointer of the old snapshot is freed once no reader
+ *     can be copying it anymore.
+ */
+void AntiMicroSettings::publishSnapshot(settingsSnapshot *values)
+{
+    QSharedPointer<const settingsSnapshot> *published = new QSharedPointer<const settingsSnapshot>(values);
+    QSharedPointer<const settingsSnapshot> *replaced = currentSnapshot.fetchAndStoreOrdered(published);
+
+    if (replaced != nullptr)
+        retiredSnapshots.append(replaced);
+
+    if (activeReaders.fetchAndAddOrdered(0) == 0)
+    {
+        qDeleteAll(retiredSnapshots);
+        retiredSnapshots.clear();
+    }
+}
+
+/**
+ * @brief Values of the current snapshot for writers. Called with the
+ *     snapshot mutex held, so the snapshot cannot be freed meanwhile.
+ */
+const AntiMicroSettings::settingsSnapshot& AntiMicroSettings::currentValues() const
+{
+    return *(*currentSnapshot.loadAcquire());
+}
+
+/**
+ * @brief Add a change to the next write and schedule one in the thread of
+ *     the settings if none is pending. Called with the snapshot mutex held.
+ */
+void AntiMicroSettings::queueWrite(const QString &key, const QVariant &value)
+{
+    pendingWrites.insert(key, value);
+
+    if (!flushQueued)
+    {
+        flushQueued = true;
+        QMetaObject::invokeMethod(this, "flushPendingWrites", Qt::QueuedConnection);
+    }
+}
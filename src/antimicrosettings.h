@@ -24,6 +24,12 @@
 #include "commandlineutility.h"
 
 #include <QSettings>
+#include <QHash>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QAtomicPointer>
+#include <QAtomicInt>
+#include <QList>
 
 
 class AntiMicroSettings : public QSettings
@@ -31,17 +37,52 @@ class AntiMicroSettings : public QSettings
     Q_OBJECT
 
 public:
+    // Stored values keyed by their full path, such as "Mouse/Smoothing".
+    // Values keep the type QSettings returns for them, which is usually
+    // a string for values read from the file. Convert them with toBool,
+    // toInt and so on like values from QSettings::value.
+    typedef QHash<QString, QVariant> settingsSnapshot;
+
     explicit AntiMicroSettings(const QString &fileName, Format format, QObject *parent = nullptr);
+    ~AntiMicroSettings();
 
     QVariant runtimeValue(const QString &key, const QVariant &defaultValue = QVariant()) const;
     void importFromCommandLine(CommandLineUtility &cmdutility);
     QMutex* getLock();
     QSettings& getCmdSettings();
 
+    QSharedPointer<const settingsSnapshot> snapshot() const;
+    QVariant snapshotValue(const QString &key, const QVariant &defaultValue = QVariant()) const;
+    void refreshSnapshot();
+    void setValueDeferred(const QString &key, const QVariant &value);
+    void removeDeferred(const QString &key);
+    bool moveDeferred(const QString &oldKey, const QString &newKey);
+
+public slots:
+    void flushPendingWrites();
+
 protected:
     QSettings cmdSettings;
     QMutex lock;
 
+private:
+    void publishSnapshot(settingsSnapshot *values);
+    void queueWrite(const QString &key, const QVariant &value);
+
+    const settingsSnapshot& currentValues() const;
+
+    // Published snapshot. Readers copy the shared pointer without a lock.
+    mutable QAtomicPointer<QSharedPointer<const settingsSnapshot> > currentSnapshot;
+    // Readers copying the shared pointer right now
+    mutable QAtomicInt activeReaders;
+    // Replaced snapshots that readers may still be copying from
+    QList<QSharedPointer<const settingsSnapshot>*> retiredSnapshots;
+    // Keys waiting to be written. An invalid value removes the key.
+    QHash<QString, QVariant> pendingWrites;
+    bool flushQueued;
+    // Serialises writers of the snapshot. Readers do not take it.
+    QMutex snapshotMutex;
+
 };
 
 #endif // ANTIMICROSETTINGS_H
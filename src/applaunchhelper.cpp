@@ -50,6 +50,7 @@ void AppLaunchHelper::initRunMethods()
         establishMouseTimerConnections();
         enablePossibleMouseSmoothing();
         changeMouseRefreshRate();
+        changeHighResolutionMouse();
         changeSpringModeScreen();
         changeGamepadPollRate();
     }
@@ -91,6 +92,14 @@ void AppLaunchHelper::changeMouseRefreshRate()
     }
 }
 
+void AppLaunchHelper::changeHighResolutionMouse()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    bool highResolutionMouse = settings->value("Mouse/HighResolution", false).toBool();
+    JoyButton::setHighResolutionMouse(highResolutionMouse, GlobalVariables::JoyButton::highResolutionMouse);
+}
+
 void AppLaunchHelper::changeGamepadPollRate()
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
@@ -108,6 +117,12 @@ void AppLaunchHelper::printControllerList(QMap<SDL_JoystickID, InputDevice *> *j
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
     QTextStream outstream(stdout);
+    writeControllerList(joysticks, outstream);
+}
+
+void AppLaunchHelper::writeControllerList(QMap<SDL_JoystickID, InputDevice *> *joysticks, QTextStream &outstream)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
 
     outstream << QObject::tr("# of joysticks found: %1").arg(joysticks->size()) << endl;
     outstream << endl;
@@ -155,9 +170,8 @@ void AppLaunchHelper::changeSpringModeScreen()
     if (springScreen >= deskWid.screenCount())
     {
         springScreen = -1;
-        settings->setValue("Mouse/SpringScreen",
-                           GlobalVariables::AntimicroSettings::defaultSpringScreen);
-        settings->sync();
+        settings->setValueDeferred("Mouse/SpringScreen",
+                                   GlobalVariables::AntimicroSettings::defaultSpringScreen);
     }
 
     JoyButton::setSpringModeScreen(springScreen, GlobalVariables::JoyButton::springModeScreen);
@@ -27,6 +27,7 @@
 class AntiMicroSettings;
 class InputDevice;
 class QThread;
+class QTextStream;
 
 class AppLaunchHelper : public QObject
 {
@@ -37,6 +38,7 @@ public:
                              QObject *parent=0);
 
     void printControllerList(QMap<SDL_JoystickID, InputDevice *> *joysticks);
+    static void writeControllerList(QMap<SDL_JoystickID, InputDevice *> *joysticks, QTextStream &outstream);
 
     AntiMicroSettings *getSettings() const;
 
@@ -45,6 +47,7 @@ protected:
     void enablePossibleMouseSmoothing();
     void establishMouseTimerConnections();
     void changeMouseRefreshRate();
+    void changeHighResolutionMouse();
     void changeSpringModeScreen();
     void changeGamepadPollRate();
 
@@ -0,0 +1,275 @@
+/* antimicroX Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ * Copyright (C) 2020 Jagoda Górska <juliagoda.pl@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "autoprofilematcher.h"
+
+#include "autoprofileinfo.h"
+
+#include <QDebug>
+#include <QQueue>
+
+
+AutoProfileMatcher::AutoProfileMatcher()
+{
+    currentStamp = 0;
+    clear();
+}
+
+void AutoProfileMatcher::clear()
+{
+    matcherEntries.clear();
+    exeIndex.clear();
+    classIndex.clear();
+    fullTitleIndex.clear();
+    titleNodes.clear();
+    entryStamps.clear();
+    entryMatchedMask.clear();
+    touchedEntries.clear();
+
+    TitleNode root;
+    root.fail = 0;
+    titleNodes.append(root);
+}
+
+void AutoProfileMatcher::addProfile(AutoProfileInfo *info)
+{
+    if (info == nullptr)
+        return;
+
+    MatcherEntry entry;
+    entry.info = info;
+    entry.requiredMask = 0;
+    entry.numProps = 0;
+
+    int entryIndex = matcherEntries.size();
+
+    if (!info->getExe().isEmpty())
+    {
+        entry.requiredMask |= ExeProperty;
+        entry.numProps++;
+        exeIndex[info->getExe()].append(entryIndex);
+    }
+
+    if (!info->getWindowClass().isEmpty())
+    {
+        entry.requiredMask |= ClassProperty;
+        entry.numProps++;
+        classIndex[info->getWindowClass()].append(entryIndex);
+    }
+
+    if (!info->getWindowName().isEmpty())
+    {
+        entry.requiredMask |= TitleProperty;
+        entry.numProps++;
+
+        if (info->isPartialState())
+            insertTitlePattern(info->getWindowName(), entryIndex);
+        else
+            fullTitleIndex[info->getWindowName()].append(entryIndex);
+    }
+
+    if (entry.requiredMask != 0)
+        matcherEntries.append(entry);
+}
+
+void AutoProfileMatcher::build()
+{
+    buildFailureLinks();
+
+    entryStamps.fill(0, matcherEntries.size());
+    entryMatchedMask.fill(0, matcherEntries.size());
+    touchedEntries.clear();
+    touchedEntries.reserve(matcherEntries.size());
+    currentStamp = 0;
+
+    qDebug() << "Auto profile matcher built with" << matcherEntries.size()
+             << "entries and" << titleNodes.size() << "title automaton states";
+}
+
+bool AutoProfileMatcher::isEmpty() const
+{
+    return matcherEntries.isEmpty();
+}
+
+bool AutoProfileMatcher::hasTitlePatterns() const
+{
+    return !fullTitleIndex.isEmpty() || (titleNodes.size() > 1);
+}
+
+bool AutoProfileMatcher::hasExePatterns() const
+{
+    return !exeIndex.isEmpty();
+}
+
+void AutoProfileMatcher::insertTitlePattern(QString const& pattern, int entryIndex)
+{
+    int state = 0;
+
+    for (int i = 0; i < pattern.size(); i++)
+    {
+        ushort character = pattern.at(i).unicode();
+        int nextState = titleNodes.at(state).next.value(character, -1);
+
+        if (nextState == -1)
+        {
+            TitleNode node;
+            node.fail = 0;
+            nextState = titleNodes.size();
+            titleNodes.append(node);
+            titleNodes[state].next.insert(character, nextState);
+        }
+
+        state = nextState;
+    }
+
+    titleNodes[state].entries.append(entryIndex);
+}
+
+void AutoProfileMatcher::buildFailureLinks()
+{
+    QQueue<int> pending;
+
+    QHashIterator<ushort, int> rootIter(titleNodes.at(0).next);
+    while (rootIter.hasNext())
+    {
+        rootIter.next();
+        titleNodes[rootIter.value()].fail = 0;
+        pending.enqueue(rootIter.value());
+    }
+
+    // Breadth-first order guarantees that a failure target is complete
+    // (including inherited entries) before any deeper node refers to it.
+    while (!pending.isEmpty())
+    {
+        int state = pending.dequeue();
+        QHash<ushort, int> children = titleNodes.at(state).next;
+        QHashIterator<ushort, int> iter(children);
+
+        while (iter.hasNext())
+        {
+            iter.next();
+            ushort character = iter.key();
+            int child = iter.value();
+            int fallback = titleNodes.at(state).fail;
+
+            while ((fallback != 0) && !titleNodes.at(fallback).next.contains(character))
+                fallback = titleNodes.at(fallback).fail;
+
+            int target = titleNodes.at(fallback).next.value(character, 0);
+            if (target == child) target = 0;
+
+            titleNodes[child].fail = target;
+            titleNodes[child].entries += titleNodes.at(target).entries;
+            pending.enqueue(child);
+        }
+    }
+}
+
+void AutoProfileMatcher::markEntries(QList<int> const& entries, int property)
+{
+    for (int entryIndex : entries)
+        markEntry(entryIndex, property);
+}
+
+void AutoProfileMatcher::markEntry(int entryIndex, int property)
+{
+    if (entryStamps.at(entryIndex) != currentStamp)
+    {
+        entryStamps[entryIndex] = currentStamp;
+        entryMatchedMask[entryIndex] = 0;
+        touchedEntries.append(entryIndex);
+    }
+
+    entryMatchedMask[entryIndex] |= property;
+}
+
+/**
+ * @brief Collects every assignment touched by the current window in one pass
+ *   and keeps, for each unique ID, the active assignment with the highest
+ *   number of matched properties. An assignment only counts when all of its
+ *   defined properties match.
+ */
+QHash<QString, AutoProfileInfo*> AutoProfileMatcher::findBestMatches(QString const& appLocation,
+                                                                    QString const& baseAppFileName,
+                                                                    QString const& windowClass,
+                                                                    QString const& windowTitle)
+{
+    QHash<QString, AutoProfileInfo*> highestMatches;
+
+    if (matcherEntries.isEmpty())
+        return highestMatches;
+
+    currentStamp++;
+
+    if (currentStamp == 0)
+    {
+        entryStamps.fill(0);
+        currentStamp = 1;
+    }
+
+    touchedEntries.clear();
+
+    if (!appLocation.isEmpty())
+        markEntries(exeIndex.value(appLocation), ExeProperty);
+
+    if (!baseAppFileName.isEmpty() && (baseAppFileName != appLocation))
+        markEntries(exeIndex.value(baseAppFileName), ExeProperty);
+
+    if (!windowClass.isEmpty())
+        markEntries(classIndex.value(windowClass), ClassProperty);
+
+    if (!windowTitle.isEmpty())
+    {
+        markEntries(fullTitleIndex.value(windowTitle), TitleProperty);
+
+        int state = 0;
+
+        for (int i = 0; (i < windowTitle.size()) && (titleNodes.size() > 1); i++)
+        {
+            ushort character = windowTitle.at(i).unicode();
+
+            while ((state != 0) && !titleNodes.at(state).next.contains(character))
+                state = titleNodes.at(state).fail;
+
+            state = titleNodes.at(state).next.value(character, 0);
+
+            for (int entryIndex : titleNodes.at(state).entries)
+                markEntry(entryIndex, TitleProperty);
+        }
+    }
+
+    QHash<QString, int> highestMatchCount;
+
+    for (int entryIndex : touchedEntries)
+    {
+        MatcherEntry const& entry = matcherEntries.at(entryIndex);
+
+        if ((entryMatchedMask.at(entryIndex) != entry.requiredMask) || !entry.info->isActive())
+            continue;
+
+        QString uniqueID = entry.info->getUniqueID();
+
+        if (!highestMatchCount.contains(uniqueID) || (entry.numProps > highestMatchCount.value(uniqueID)))
+        {
+            highestMatchCount.insert(uniqueID, entry.numProps);
+            highestMatches.insert(uniqueID, entry.info);
+        }
+    }
+
+    return highestMatches;
+}
@@ -0,0 +1,93 @@
+/* antimicroX Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ * Copyright (C) 2020 Jagoda Górska <juliagoda.pl@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef AUTOPROFILEMATCHER_H
+#define AUTOPROFILEMATCHER_H
+
+#include <QHash>
+#include <QList>
+#include <QVector>
+#include <QString>
+
+class AutoProfileInfo;
+
+/**
+ * @brief Lookup index for auto profile assignments. It is rebuilt every time
+ * assignments are synced from settings, so that checking the focused window
+ * against all of them is done in one pass: exe paths and window classes
+ * through exact hashes, full titles through a hash and partial titles
+ * through an Aho-Corasick automaton built from all partial patterns.
+ */
+class AutoProfileMatcher
+{
+public:
+    AutoProfileMatcher();
+
+    void clear();
+    void addProfile(AutoProfileInfo *info);
+    void build();
+    bool isEmpty() const;
+    bool hasTitlePatterns() const;
+    bool hasExePatterns() const;
+
+    QHash<QString, AutoProfileInfo*> findBestMatches(QString const& appLocation,
+                                                     QString const& baseAppFileName,
+                                                     QString const& windowClass,
+                                                     QString const& windowTitle);
+
+private:
+    enum MatchedProperty {
+        ExeProperty = 1 << 0,
+        ClassProperty = 1 << 1,
+        TitleProperty = 1 << 2
+    };
+
+    typedef struct _MatcherEntry
+    {
+        AutoProfileInfo *info;
+        int requiredMask;
+        int numProps;
+    } MatcherEntry;
+
+    typedef struct _TitleNode
+    {
+        QHash<ushort, int> next;
+        int fail;
+        QVector<int> entries; // entry indexes of patterns ending here, incl. suffixes
+    } TitleNode;
+
+    void insertTitlePattern(QString const& pattern, int entryIndex);
+    void buildFailureLinks();
+    void markEntries(QList<int> const& entries, int property);
+    void markEntry(int entryIndex, int property);
+
+    QVector<MatcherEntry> matcherEntries;
+    QHash<QString, QList<int> > exeIndex;
+    QHash<QString, QList<int> > classIndex;
+    QHash<QString, QList<int> > fullTitleIndex;
+    QVector<TitleNode> titleNodes;
+
+    // Per-check scratch state. Entries are only reset when their stamp
+    // is older than the current check, so no clearing pass is needed.
+    QVector<unsigned int> entryStamps;
+    QVector<int> entryMatchedMask;
+    QVector<int> touchedEntries;
+    unsigned int currentStamp;
+};
+
+#endif // AUTOPROFILEMATCHER_H
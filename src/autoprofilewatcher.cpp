@@ -133,10 +133,12 @@ void AutoProfileWatcher::runAppCheck()
         nowWindow = QString::number(currentWindow);
         qDebug() << "number of window now: " << nowWindow << endl;
 
-        nowWindowClass = X11Extras::getInstance()->getWindowClass(static_cast<Window>(currentWindow));
+        X11Extras::windowInformation windowInfo = X11Extras::getInstance()->getWindowInfo(static_cast<Window>(currentWindow));
+
+        nowWindowClass = windowInfo.windowClass;
         qDebug() << "class of window now: " << nowWindowClass << endl;
 
-        nowWindowName = X11Extras::getInstance()->getWindowTitle(static_cast<Window>(currentWindow));
+        nowWindowName = windowInfo.title;
         qDebug() << "title of window now: " << nowWindowName << endl;
     }
 
@@ -161,136 +163,9 @@ void AutoProfileWatcher::runAppCheck()
                      "Class = \"%2\", Program = \"%3\" or \"%4\".").
              arg(nowWindowName, nowWindowClass, appLocation, baseAppFileName));
 
-        QSet<AutoProfileInfo*> fullSet;
-
-        if (!appLocation.isEmpty() && getAppProfileAssignments().contains(appLocation))
-        {
-            QSet<AutoProfileInfo*> tempSet;
-            tempSet = getAppProfileAssignments().value(appLocation).toSet();
-            fullSet.unite(tempSet);
-        }
-        else if (!baseAppFileName.isEmpty() && getAppProfileAssignments().contains(baseAppFileName))
-        {
-            QSet<AutoProfileInfo*> tempSet;
-            tempSet = getAppProfileAssignments().value(baseAppFileName).toSet();
-            fullSet.unite(tempSet);
-        }
-
-        if (!nowWindowClass.isEmpty() && getWindowClassProfileAssignments().contains(nowWindowClass))
-        {
-            QSet<AutoProfileInfo*> tempSet;
-            tempSet = getWindowClassProfileAssignments().value(nowWindowClass).toSet();
-            fullSet.unite(tempSet);
-        }
-
-        // part window title
-        if (!nowWindowName.isEmpty())
-        {
-            QHashIterator< QString, QList< AutoProfileInfo *> > iter(getWindowNameProfileAssignments());
-            while (iter.hasNext())
-            {
-                iter.next();
-
-                bool hasOnePartName = false;
-
-                QListIterator< AutoProfileInfo* > iterList(iter.value());
-                while (iterList.hasNext()) {
-
-                    AutoProfileInfo* autoInfo = iterList.next();
-
-                    if (autoInfo->isPartialState()) {
-                        hasOnePartName = true;
-                        break;
-                    }
-                }
-
-                if (hasOnePartName) {
-
-                    qDebug() << "IT HAS A PARTIAL TITLE NAME";
-
-                    if (nowWindowName.contains(iter.key())) {
-
-                        qDebug() << "WINDOW: \"" << nowWindowName << "\" includes \"" << iter.key() << "\"";
-
-                        QSet< AutoProfileInfo* > tempSet;
-                        QList< AutoProfileInfo *> list = iter.value();
-                        tempSet = list.toSet();
-                        fullSet = fullSet.unite(tempSet);
-
-                    } else {
-
-                        qDebug() << "WINDOW: \"" << nowWindowName << "\" doesn't include \"" << iter.key() << "\"";
-                    }
-
-                } else {
-
-                    qDebug() << "IT HAS A FULL TITLE NAME";
-
-                    if (iter.key() == nowWindowName) {
-
-                        qDebug() << "WINDOW: \"" << nowWindowName << "\" is equal to hash key: \"" << iter.key() << "\"";
-
-                        QSet<AutoProfileInfo*> tempSet;
-                        tempSet = getWindowNameProfileAssignments().value(nowWindowName).toSet();
-                        fullSet = fullSet.unite(tempSet);
-
-                    } else {
-
-                        qDebug() << "WINDOW: \"" << nowWindowName << "\" is not equal to hash key: \"" << iter.key() << "\"";
-                    }
-                }
-            }
-        }
-
-        QHash<QString, int> highestMatchCount;
-        QHash<QString, AutoProfileInfo*> highestMatches;
-
-        QSetIterator<AutoProfileInfo*> fullSetIter(fullSet);
-        while (fullSetIter.hasNext())
-        {
-            AutoProfileInfo *info = fullSetIter.next();
-            if (info->isActive())
-            {
-                int numProps = 0;
-                numProps += !info->getExe().isEmpty() ? 1 : 0;
-                numProps += !info->getWindowClass().isEmpty() ? 1 : 0;
-                numProps += !info->getWindowName().isEmpty() ? 1 : 0;
-
-                int numMatched = 0;
-                numMatched += (!info->getExe().isEmpty() &&
-                               (info->getExe() == appLocation ||
-                                info->getExe() == baseAppFileName)) ? 1 : 0;
-                numMatched += (!info->getWindowClass().isEmpty() &&
-                               info->getWindowClass() == nowWindowClass) ? 1 : 0;
-
-
-                if (info->isPartialState()) {
-
-                    numMatched += (!info->getWindowName().isEmpty() &&
-                                   nowWindowName.contains(info->getWindowName())) ? 1 : 0;
-                } else {
-
-                    numMatched += (!info->getWindowName().isEmpty() &&
-                                   info->getWindowName() == nowWindowName) ? 1 : 0;
-                }
-
-
-                if (numProps == numMatched && highestMatchCount.contains(info->getUniqueID()))
-                {
-                    int currentHigh = highestMatchCount.value(info->getUniqueID());
-                    if (numMatched > currentHigh)
-                    {
-                        highestMatchCount.insert(info->getUniqueID(), numMatched);
-                        highestMatches.insert(info->getUniqueID(), info);
-                    }
-                }
-                else if (numProps == numMatched && !highestMatchCount.contains(info->getUniqueID()))
-                {
-                    highestMatchCount.insert(info->getUniqueID(), numMatched);
-                    highestMatches.insert(info->getUniqueID(), info);
-                }
-            }
-        }
+        QHash<QString, AutoProfileInfo*> highestMatches =
+                profileMatcher.findBestMatches(appLocation, baseAppFileName,
+                                               nowWindowClass, nowWindowName);
 
         QHashIterator<QString, AutoProfileInfo*> highIter(highestMatches);
 
@@ -332,8 +207,10 @@ void AutoProfileWatcher::syncProfileAssignment()
 
     currentApplication = "";
 
-    settings->getLock()->lock();
-    settings->beginGroup("DefaultAutoProfiles");
+    // Read from a snapshot so that the settings lock is not held while
+    // the assignments are rebuilt.
+    QSharedPointer<const AntiMicroSettings::settingsSnapshot> values = settings->snapshot();
+
     QString exe = QString();
     QString uniqueID = QString();
     QString profile = QString();
@@ -341,12 +218,10 @@ void AutoProfileWatcher::syncProfileAssignment()
     QString windowClass = QString();
     QString windowName = QString();
 
-    QStringList registeredUniques = settings->value("Uniques", QStringList()).toStringList();
-
-    settings->endGroup();
+    QStringList registeredUniques = values->value("DefaultAutoProfiles/Uniques", QStringList()).toStringList();
 
-    QString allProfile = settings->value(QString("DefaultAutoProfileAll/Profile"), "all").toString();
-    QString allActive = settings->value(QString("DefaultAutoProfileAll/Active"), "0").toString();
+    QString allProfile = values->value(QString("DefaultAutoProfileAll/Profile"), "all").toString();
+    QString allActive = values->value(QString("DefaultAutoProfileAll/Active"), "0").toString();
 
     // Handle overall Default profile assignment
     bool defaultActive = allActive == "1" ? true : false;
@@ -364,12 +239,12 @@ void AutoProfileWatcher::syncProfileAssignment()
     {
         QString tempkey = iter.next();
         QString uniqueID = QString(tempkey).replace("UniqueID", "");
-        QString profile = settings->value(QString("DefaultAutoProfile-%1/Profile").arg(uniqueID), "").toString();
-        QString active = settings->value(QString("DefaultAutoProfile-%1/Active").arg(uniqueID), "").toString();
-        QString exe = settings->value(QString("DefaultAutoProfile-%1/Exe").arg(uniqueID), "").toString();
-        QString partialTitle = settings->value(QString("DefaultAutoProfile-%1/PartialTitle").arg(uniqueID), "").toString();
-        QString windowClass = settings->value(QString("DefaultAutoProfile-%1/WindowClass").arg(uniqueID), "").toString();
-        QString windowName = settings->value(QString("DefaultAutoProfile-%1/WindowName").arg(uniqueID), "").toString();
+        QString profile = values->value(QString("DefaultAutoProfile-%1/Profile").arg(uniqueID), "").toString();
+        QString active = values->value(QString("DefaultAutoProfile-%1/Active").arg(uniqueID), "").toString();
+        QString exe = values->value(QString("DefaultAutoProfile-%1/Exe").arg(uniqueID), "").toString();
+        QString partialTitle = values->value(QString("DefaultAutoProfile-%1/PartialTitle").arg(uniqueID), "").toString();
+        QString windowClass = values->value(QString("DefaultAutoProfile-%1/WindowClass").arg(uniqueID), "").toString();
+        QString windowName = values->value(QString("DefaultAutoProfile-%1/WindowName").arg(uniqueID), "").toString();
 
         // need to change when it's needed to add windowClass, title and partial name
         if (!uniqueID.isEmpty() && !profile.isEmpty())
@@ -389,26 +264,26 @@ void AutoProfileWatcher::syncProfileAssignment()
         }
     }
 
-    settings->beginGroup("AutoProfiles");
     bool quitSearch = false;
 
     for (int i = 1; !quitSearch; i++)
     {
-        exe = settings->value(QString("AutoProfile%1Exe").arg(i), "").toString();
+        exe = values->value(QString("AutoProfiles/AutoProfile%1Exe").arg(i), "").toString();
         exe = QDir::toNativeSeparators(exe);
 
-        convToUniqueIDAutoProfGroupSett(settings, QString("AutoProfile%1GUID").arg(i), QString("AutoProfile%1UniqueID").arg(i));
+        if (convToUniqueIDAutoProfGroupSett(settings, QString("AutoProfiles/AutoProfile%1GUID").arg(i), QString("AutoProfiles/AutoProfile%1UniqueID").arg(i)))
+            values = settings->snapshot();
 
-        uniqueID = settings->value(QString("AutoProfile%1UniqueID").arg(i), "").toString();
-        profile = settings->value(QString("AutoProfile%1Profile").arg(i), "").toString();
-        active = settings->value(QString("AutoProfile%1Active").arg(i), 0).toString();
-        windowName = settings->value(QString("AutoProfile%1WindowName").arg(i), "").toString();
-        QString partialTitle = settings->value(QString("AutoProfile%1PartialTitle").arg(i), 0).toString();
+        uniqueID = values->value(QString("AutoProfiles/AutoProfile%1UniqueID").arg(i), "").toString();
+        profile = values->value(QString("AutoProfiles/AutoProfile%1Profile").arg(i), "").toString();
+        active = values->value(QString("AutoProfiles/AutoProfile%1Active").arg(i), 0).toString();
+        windowName = values->value(QString("AutoProfiles/AutoProfile%1WindowName").arg(i), "").toString();
+        QString partialTitle = values->value(QString("AutoProfiles/AutoProfile%1PartialTitle").arg(i), 0).toString();
         bool partialTitleBool = partialTitle == "1" ? true : false;
 
 
 #ifdef Q_OS_UNIX
-        windowClass = settings->value(QString("AutoProfile%1WindowClass").arg(i), "").toString();
+        windowClass = values->value(QString("AutoProfiles/AutoProfile%1WindowClass").arg(i), "").toString();
 #else
         windowClass.clear();
 #endif
@@ -493,6 +368,8 @@ void AutoProfileWatcher::syncProfileAssignment()
                         appProfileAssignments.insert(baseExe, templist);
                     }
                 }
+
+                profileMatcher.addProfile(info);
             }
         }
         else
@@ -501,8 +378,7 @@ void AutoProfileWatcher::syncProfileAssignment()
         }
     }
 
-    settings->endGroup();
-    settings->getLock()->unlock();
+    profileMatcher.build();
 }
 
 
@@ -566,6 +442,7 @@ void AutoProfileWatcher::clearProfileAssignments()
     }
 
     defaultProfileAssignments.clear();
+    profileMatcher.clear();
     allDefaultInfo = nullptr;
     getUniqeIDSetLocal().clear();
 }
@@ -646,11 +523,12 @@ QSet<QString>& AutoProfileWatcher::getUniqeIDSetLocal() {
 }
 
 
-void AutoProfileWatcher::convToUniqueIDAutoProfGroupSett(QSettings* sett, QString guidAutoProfSett, QString uniqueAutoProfSett)
+/**
+ * @brief Move an assignment stored under a GUID by older versions to the
+ *     unique ID. The snapshot changes right away, the settings file later.
+ * @return Whether anything was moved
+ */
+bool AutoProfileWatcher::convToUniqueIDAutoProfGroupSett(AntiMicroSettings* sett, QString guidAutoProfSett, QString uniqueAutoProfSett)
 {
-    if (sett->contains(guidAutoProfSett))
-    {
-        sett->setValue(uniqueAutoProfSett, sett->value(guidAutoProfSett));
-        sett->remove(guidAutoProfSett);
-    }
+    return sett->moveDeferred(guidAutoProfSett, uniqueAutoProfSett);
 }
@@ -20,6 +20,8 @@
 #ifndef AUTOPROFILEWATCHER_H
 #define AUTOPROFILEWATCHER_H
 
+#include "autoprofilematcher.h"
+
 #include <QTimer>
 #include <QHash>
 #include <QSet>
@@ -55,7 +57,7 @@ public:
 protected:
     QString findAppLocation();
     void clearProfileAssignments();
-    void convToUniqueIDAutoProfGroupSett(QSettings* sett, QString guidAutoProfSett, QString uniqueAutoProfSett);
+    bool convToUniqueIDAutoProfGroupSett(AntiMicroSettings* sett, QString guidAutoProfSett, QString uniqueAutoProfSett);
 
 signals:
     void foundApplicableProfile(AutoProfileInfo *info);
@@ -77,6 +79,7 @@ private:
     QHash<QString, QList<AutoProfileInfo*> > windowClassProfileAssignments;
     QHash<QString, QList<AutoProfileInfo*> > windowNameProfileAssignments;
     QHash<QString, AutoProfileInfo*> defaultProfileAssignments;
+    AutoProfileMatcher profileMatcher;
     AutoProfileInfo *allDefaultInfo;
     QString currentApplication;
     QString currentAppWindowTitle;
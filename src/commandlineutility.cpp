@@ -45,6 +45,7 @@ CommandLineUtility::CommandLineUtility(QObject *parent) :
     daemonMode = false;
     displayString = "";
     listControllers = false;
+    queryStats = false;
     mappingController = false;
     currentLogLevel = Logger::LOG_NONE;
 
@@ -120,6 +121,11 @@ void CommandLineUtility::parseArguments(QCommandLineParser* parser) {
             listControllers = true;
         }
 
+        if (parser->isSet("stats"))
+        {
+            queryStats = true;
+        }
+
         if (parser->isSet("map"))
         {
             parseArgsMap(parser);
@@ -469,6 +475,13 @@ bool CommandLineUtility::shouldListControllers()
     return listControllers;
 }
 
+bool CommandLineUtility::shouldQueryStats()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    return queryStats;
+}
+
 bool CommandLineUtility::shouldMapController()
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
@@ -134,6 +134,7 @@ public:
     bool isHiddenRequested();
     bool isUnloadRequested();
     bool shouldListControllers();
+    bool shouldQueryStats();
     bool shouldMapController();
     bool hasProfileInOptions();
     bool hasError();
@@ -167,6 +168,7 @@ private:
     bool unloadProfile;
     bool daemonMode;
     bool listControllers;
+    bool queryStats;
     bool mappingController;
 
     int startSetNumber;
@@ -0,0 +1,297 @@
+/* antimicroX Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ * Copyright (C) 2020 Jagoda Górska <juliagoda.pl@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "deviceregistry.h"
+
+#include "messagehandler.h"
+#include "antimicrosettings.h"
+
+#include <QMutexLocker>
+#include <QDebug>
+
+
+DeviceRegistry* DeviceRegistry::instance = nullptr;
+QMutex DeviceRegistry::instanceMutex;
+
+
+static DeviceRegistry::deviceRegistryEntry& entryFor(QHash<QString, DeviceRegistry::deviceRegistryEntry> &entries,
+                                                     QString const& identifier)
+{
+    if (!entries.contains(identifier))
+    {
+        DeviceRegistry::deviceRegistryEntry entry;
+        entry.disableGameController = false;
+        entries.insert(identifier, entry);
+    }
+
+    return entries[identifier];
+}
+
+
+DeviceRegistry::DeviceRegistry(QObject *parent) :
+    QObject(parent)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    settings = nullptr;
+    flushQueued = false;
+}
+
+DeviceRegistry::~DeviceRegistry()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    flush();
+}
+
+/**
+ * @brief Get the registry. The first call should come from the main
+ *     thread since write-back runs in the thread the registry lives in.
+ */
+DeviceRegistry* DeviceRegistry::getInstance()
+{
+    QMutexLocker locker(&instanceMutex);
+
+    if (instance == nullptr)
+        instance = new DeviceRegistry();
+
+    return instance;
+}
+
+/**
+ * @brief Write pending changes and delete the registry. Must be called
+ *     before the settings object is deleted.
+ */
+void DeviceRegistry::deleteInstance()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    QMutexLocker locker(&instanceMutex);
+
+    if (instance != nullptr)
+    {
+        delete instance;
+        instance = nullptr;
+    }
+}
+
+/**
+ * @brief Read mappings and disable flags of all known devices. Changes not written back yet are dropped, so call
+ *     this again after code writes the Mappings group directly.
+ * @param Settings to read from and write back to
+ */
+void DeviceRegistry::load(AntiMicroSettings *settings)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    QHash<QString, deviceRegistryEntry> loaded;
+
+    settings->getLock()->lock();
+
+    settings->beginGroup("Mappings");
+    QStringListIterator mappingIter(settings->allKeys());
+
+    while (mappingIter.hasNext())
+    {
+        QString key = mappingIter.next();
+
+        if (key.endsWith("Disable"))
+        {
+            QString identifier = key.left(key.length() - QString("Disable").length());
+            entryFor(loaded, identifier).disableGameController = settings->value(key, false).toBool();
+        }
+        else
+        {
+            entryFor(loaded, key).mapping = settings->value(key, QString()).toString();
+        }
+    }
+
+    settings->endGroup();
+
+    settings->getLock()->unlock();
+
+    QMutexLocker locker(&entriesMutex);
+    this->settings = settings;
+    entries = loaded;
+    pendingWrites.clear();
+}
+
+/**
+ * @brief Find the settings of a device. An entry still stored under the
+ *     plain GUID by older versions is moved to the unique ID first.
+ * @param GUID of the device
+ * @param Unique ID of the device
+ * @param Receives the entry. Default values when nothing is stored.
+ * @return Whether anything is stored for the device
+ */
+bool DeviceRegistry::lookup(QString guidString, QString uniqueIdString, deviceRegistryEntry &entry)
+{
+    QMutexLocker locker(&entriesMutex);
+
+    migrateEntry(guidString, uniqueIdString);
+
+    bool found = entries.contains(uniqueIdString);
+
+    if (found)
+    {
+        entry = entries.value(uniqueIdString);
+    }
+    else
+    {
+        entry.mapping = QString();
+        entry.disableGameController = false;
+    }
+
+    return found;
+}
+
+/**
+ * @brief Get all stored SDL mapping strings.
+ */
+QStringList DeviceRegistry::getMappings()
+{
+    QMutexLocker locker(&entriesMutex);
+
+    QStringList mappings;
+    QHashIterator<QString, deviceRegistryEntry> iter(entries);
+
+    while (iter.hasNext())
+    {
+        iter.next();
+
+        if (!iter.value().mapping.isEmpty())
+            mappings.append(iter.value().mapping);
+    }
+
+    return mappings;
+}
+
+void DeviceRegistry::setMapping(QString uniqueIdString, QString mapping)
+{
+    QMutexLocker locker(&entriesMutex);
+
+    entryFor(entries, uniqueIdString).mapping = mapping;
+    queueWrite(QString("Mappings/%1").arg(uniqueIdString), mapping);
+}
+
+void DeviceRegistry::setGameControllerDisabled(QString uniqueIdString, bool disabled)
+{
+    QMutexLocker locker(&entriesMutex);
+
+    entryFor(entries, uniqueIdString).disableGameController = disabled;
+    queueWrite(QString("Mappings/%1Disable").arg(uniqueIdString), disabled ? "1" : "0");
+}
+
+/**
+ * @brief Forget the mapping and disable flag of a device.
+ */
+void DeviceRegistry::removeMapping(QString uniqueIdString)
+{
+    QMutexLocker locker(&entriesMutex);
+
+    entries.remove(uniqueIdString);
+
+    queueWrite(QString("Mappings/%1").arg(uniqueIdString), QVariant());
+    queueWrite(QString("Mappings/%1Disable").arg(uniqueIdString), QVariant());
+}
+
+/**
+ * @brief Write pending changes to the settings.
+ */
+void DeviceRegistry::flush()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    entriesMutex.lock();
+    QHash<QString, QVariant> writes = pendingWrites;
+    AntiMicroSettings *target = settings;
+    pendingWrites.clear();
+    flushQueued = false;
+    entriesMutex.unlock();
+
+    if (writes.isEmpty() || (target == nullptr))
+        return;
+
+    target->getLock()->lock();
+
+    QHashIterator<QString, QVariant> iter(writes);
+
+    while (iter.hasNext())
+    {
+        iter.next();
+
+        if (iter.value().isValid()) target->setValue(iter.key(), iter.value());
+        else target->remove(iter.key());
+    }
+
+    target->getLock()->unlock();
+
+    target->refreshSnapshot();
+}
+
+/**
+ * @brief Move an entry stored under a plain GUID to the unique ID, the
+ *     same way older versions converted their settings. Called with the
+ *     entries mutex held.
+ */
+void DeviceRegistry::migrateEntry(QString guidString, QString uniqueIdString)
+{
+    if (guidString.isEmpty() || (guidString == uniqueIdString) ||
+        entries.contains(uniqueIdString) || !entries.contains(guidString))
+    {
+        return;
+    }
+
+    deviceRegistryEntry entry = entries.take(guidString);
+
+    if (!entry.mapping.isEmpty())
+    {
+        QStringList fields = entry.mapping.split(",");
+        fields.removeFirst();
+        fields.prepend(uniqueIdString);
+        entry.mapping = fields.join(",");
+
+        queueWrite(QString("Mappings/%1").arg(uniqueIdString), entry.mapping);
+        queueWrite(QString("Mappings/%1").arg(guidString), QVariant());
+    }
+
+    if (entry.disableGameController)
+    {
+        queueWrite(QString("Mappings/%1Disable").arg(uniqueIdString), "1");
+        queueWrite(QString("Mappings/%1Disable").arg(guidString), QVariant());
+    }
+
+    entries.insert(uniqueIdString, entry);
+}
+
+/**
+ * @brief Add a settings change to the next write-back and schedule one in
+ *     the thread of the registry if none is pending. Called with the
+ *     entries mutex held.
+ */
+void DeviceRegistry::queueWrite(QString key, QVariant value)
+{
+    pendingWrites.insert(key, value);
+
+    if (!flushQueued)
+    {
+        flushQueued = true;
+        QMetaObject::invokeMethod(this, "flush", Qt::QueuedConnection);
+    }
+}
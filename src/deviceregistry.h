@@ -0,0 +1,83 @@
+/* antimicroX Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ * Copyright (C) 2020 Jagoda Górska <juliagoda.pl@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef DEVICEREGISTRY_H
+#define DEVICEREGISTRY_H
+
+#include <QObject>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+
+class AntiMicroSettings;
+
+
+/**
+ * @brief In-memory copy of the per device settings needed when a device
+ *     is opened: its SDL mapping string and whether game controller mode
+ *     is disabled. Loaded from the settings once. Changes to mappings are
+ *     written back from the thread owning the registry, outside of the
+ *     device open path.
+ */
+class DeviceRegistry : public QObject
+{
+    Q_OBJECT
+
+public:
+    typedef struct _deviceRegistryEntry
+    {
+        QString mapping;
+        bool disableGameController;
+    } deviceRegistryEntry;
+
+    static DeviceRegistry* getInstance();
+    static void deleteInstance();
+
+    void load(AntiMicroSettings *settings);
+    bool lookup(QString guidString, QString uniqueIdString, deviceRegistryEntry &entry);
+    QStringList getMappings();
+
+    void setMapping(QString uniqueIdString, QString mapping);
+    void setGameControllerDisabled(QString uniqueIdString, bool disabled);
+    void removeMapping(QString uniqueIdString);
+
+public slots:
+    void flush();
+
+private:
+    explicit DeviceRegistry(QObject *parent = nullptr);
+    ~DeviceRegistry();
+
+    void migrateEntry(QString guidString, QString uniqueIdString);
+    void queueWrite(QString key, QVariant value);
+
+    AntiMicroSettings *settings;
+    QHash<QString, deviceRegistryEntry> entries;
+    // Settings keys waiting to be written. An invalid value removes the key.
+    QHash<QString, QVariant> pendingWrites;
+    bool flushQueued;
+    QMutex entriesMutex;
+
+    static DeviceRegistry *instance;
+    static QMutex instanceMutex;
+};
+
+#endif // DEVICEREGISTRY_H
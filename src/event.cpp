@@ -24,7 +24,6 @@
 #include <QStringList>
 #include <QCursor>
 #include <QDesktopWidget>
-#include <QProcess>
 #include <QDebug>
 #include <QMessageBox>
 
@@ -33,6 +32,7 @@
 #include "messagehandler.h"
 #include "eventhandlerfactory.h"
 #include "joybutton.h"
+#include "processlauncher.h"
 
 
 #if defined(WITH_X11)
@@ -116,7 +116,10 @@ void sendevent(JoyButtonSlot *slot, bool pressed)
     }
     else if ((device == JoyButtonSlot::JoyTextEntry) && pressed && !slot->getTextData().isEmpty())
     {
-        EventHandlerFactory::getInstance()->handler()->sendTextEntryEvent(slot->getTextData());
+        QSharedPointer<const JoyButtonSlot::compiledTextEntry> plan = slot->getTextEntryPlan();
+
+        if (!plan.isNull()) EventHandlerFactory::getInstance()->handler()->sendTextEntryPlan(plan->strokes);
+        else EventHandlerFactory::getInstance()->handler()->sendTextEntryEvent(slot->getTextData());
     }
     else if ((device == JoyButtonSlot::JoyExecute) && pressed && !slot->getTextData().isEmpty())
     {
@@ -124,14 +127,11 @@ void sendevent(JoyButtonSlot *slot, bool pressed)
         {
             QString argumentsString = slot->getExtraData().toString();
             //QStringList argumentsTempList(PadderCommon::parseArgumentsString(argumentsString));
-            bool success = QProcess::startDetached(QString("%1 %2 %3").arg(detectedScriptExt(slot->getTextData())).arg(slot->getTextData()).arg(argumentsString));
-            if (!success) qDebug() << "Script cannot be executed";
+            ProcessLauncher::getInstance()->launch(slot->getTextData(), argumentsString);
         }
         else
         {
-            bool success = QProcess::startDetached(QString("%1 %2").arg(detectedScriptExt(slot->getTextData())).arg(slot->getTextData()));
-            if (!success) qDebug() << "Script cannot be executed";
-
+            ProcessLauncher::getInstance()->launch(slot->getTextData());
         }
     }
 }
@@ -90,6 +90,11 @@ EventHandlerFactory* EventHandlerFactory::getInstance(QString handler)
     return instance;
 }
 
+bool EventHandlerFactory::hasInstance()
+{
+    return instance != nullptr;
+}
+
 void EventHandlerFactory::deleteInstance()
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
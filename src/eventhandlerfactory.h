@@ -63,6 +63,7 @@ class EventHandlerFactory : public QObject
 
 public:
     static EventHandlerFactory* getInstance(QString handler = "");
+    static bool hasInstance();
     void deleteInstance();
     BaseEventHandler* handler();
     static QString fallBackIdentifier();
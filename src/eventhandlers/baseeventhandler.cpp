@@ -44,6 +44,12 @@ QString BaseEventHandler::getErrorString()
     return lastErrorString;
 }
 
+
+int BaseEventHandler::getOutputEventCount()
+{
+    return outputEventCount.loadAcquire();
+}
+
 /**
  * @brief Do nothing by default. Allow child classes to specify text to output
  *     to a text stream.
@@ -105,3 +111,80 @@ void BaseEventHandler::sendTextEntryEvent(QString maintext)
 
     Q_UNUSED(maintext);
 }
+
+/**
+ * @brief Resolve text to native key codes ahead of time. Not supported by
+ *     default.
+ * @param Text to type
+ * @param Resolved strokes
+ * @return True when plan can be passed to sendTextEntryPlan
+ */
+bool BaseEventHandler::compileTextEntry(QString maintext, QVector<textEntryStroke> &plan)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    Q_UNUSED(maintext);
+
+    plan.clear();
+    return false;
+}
+
+/**
+ * @brief Do nothing by default. Useful for child classes to define behavior.
+ * @param Strokes built by compileTextEntry
+ */
+void BaseEventHandler::sendTextEntryPlan(QVector<textEntryStroke> const& plan)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    Q_UNUSED(plan);
+}
+
+/**
+ * @brief Number that changes whenever key codes resolved earlier by
+ *     compileTextEntry may have become stale.
+ */
+int BaseEventHandler::getKeyMappingGeneration()
+{
+    return 0;
+}
+
+/**
+ * @brief Whether relative motion may exceed the range of a single pointer
+ *     event and wheel motion may be sent in fractions of a notch.
+ */
+bool BaseEventHandler::hasHighResolutionOutput()
+{
+    return false;
+}
+
+/**
+ * @brief Scroll by a fraction of a wheel notch. Only used when
+ *     hasHighResolutionOutput returns true. Send a whole notch by default.
+ * @param Mouse wheel slot
+ * @param Distance in 1/120 of a notch
+ */
+void BaseEventHandler::sendMouseWheelEvent(JoyButtonSlot *slot, int units)
+{
+    Q_UNUSED(units);
+
+    sendMouseButtonEvent(slot, true);
+    sendMouseButtonEvent(slot, false);
+}
+
+/**
+ * @brief Mark the start of one input pass or mouse tick. Output produced
+ *     until the matching endOutputFrame call may be held back and sent at
+ *     once. Frames can nest. Do nothing by default.
+ */
+void BaseEventHandler::beginOutputFrame()
+{
+}
+
+/**
+ * @brief Mark the end of a frame started with beginOutputFrame.
+ *     Do nothing by default.
+ */
+void BaseEventHandler::endOutputFrame()
+{
+}
@@ -21,9 +21,21 @@
 #define BASEEVENTHANDLER_H
 
 #include <QObject>
+#include <QAtomicInt>
+#include <QVector>
 
 class JoyButtonSlot;
 
+// One character of a text entry resolved to native key codes of the event
+// handler. Modifiers are pressed in order before the key and released in
+// reverse order after it.
+typedef struct _textEntryStroke
+{
+    unsigned int keycode;
+    unsigned int modifiers[4];
+    int modifierCount;
+} textEntryStroke;
+
 
 class BaseEventHandler : public QObject
 {
@@ -46,16 +58,36 @@ public:
     virtual void sendMouseSpringEvent(int xDis, int yDis);
 
     virtual void sendTextEntryEvent(QString maintext);
+    virtual bool compileTextEntry(QString maintext, QVector<textEntryStroke> &plan);
+    virtual void sendTextEntryPlan(QVector<textEntryStroke> const& plan);
+    virtual int getKeyMappingGeneration();
+
+    virtual bool hasHighResolutionOutput();
+    virtual void sendMouseWheelEvent(JoyButtonSlot *slot, int units);
+
+    virtual void beginOutputFrame();
+    virtual void endOutputFrame();
 
     virtual QString getName() = 0;
     virtual QString getIdentifier() = 0;
     virtual void printPostMessages();
     QString getErrorString();
+    int getOutputEventCount();
 
 
 protected:
+    // Called by every send method that produces output. Read by the stats
+    // query on the main thread.
+    inline void countOutputEvent()
+    {
+        outputEventCount.fetchAndAddRelaxed(1);
+    }
+
     QString lastErrorString;
 
+private:
+    QAtomicInt outputEventCount;
+
 };
 
 #endif // BASEEVENTHANDLER_H
@@ -58,6 +58,8 @@ UInputEventHandler::UInputEventHandler(QObject *parent) :
     keyboardFileHandler = 0;
     mouseFileHandler = 0;
     springMouseFileHandler = 0;
+    wheelRemainderX = 0;
+    wheelRemainderY = 0;
 }
 
 
@@ -199,6 +201,7 @@ void UInputEventHandler::sendKeyboardEvent(JoyButtonSlot *slot, bool pressed)
 
     if (device == JoyButtonSlot::JoyKeyboard)
     {
+        countOutputEvent();
         write_uinput_event(keyboardFileHandler, EV_KEY, code, pressed ? 1 : 0);
     }
 }
@@ -211,6 +214,8 @@ void UInputEventHandler::sendMouseButtonEvent(JoyButtonSlot *slot, bool pressed)
 
     if (device == JoyButtonSlot::JoyMouseButton)
     {
+        countOutputEvent();
+
         if (code <= 3)
         {
             unsigned int tempcode = BTN_LEFT;
@@ -239,7 +244,7 @@ void UInputEventHandler::sendMouseButtonEvent(JoyButtonSlot *slot, bool pressed)
         {
             if (pressed)
             {
-                write_uinput_event(mouseFileHandler, EV_REL, REL_WHEEL, 1);
+                writeWheelNotches(true, 1);
             }
 
         }
@@ -247,21 +252,21 @@ void UInputEventHandler::sendMouseButtonEvent(JoyButtonSlot *slot, bool pressed)
         {
             if (pressed)
             {
-                write_uinput_event(mouseFileHandler, EV_REL, REL_WHEEL, -1);
+                writeWheelNotches(true, -1);
             }
         }
         else if (code == 6)
         {
             if (pressed)
             {
-                write_uinput_event(mouseFileHandler, EV_REL, REL_HWHEEL, 1);
+                writeWheelNotches(false, 1);
             }
         }
         else if (code == 7)
         {
             if (pressed)
             {
-                write_uinput_event(mouseFileHandler, EV_REL, REL_HWHEEL, -1);
+                writeWheelNotches(false, -1);
             }
         }
         else if (code == 8)
@@ -276,17 +281,92 @@ void UInputEventHandler::sendMouseButtonEvent(JoyButtonSlot *slot, bool pressed)
 }
 
 
+/**
+ * @brief Scroll by whole notches. The mouse device advertises the hi-res
+ *     wheel axes, so libinput only reads those. Each notch is sent on
+ *     both axes like a real hi-res mouse does.
+ * @param Whether the vertical wheel is used
+ * @param Number of notches
+ */
+void UInputEventHandler::writeWheelNotches(bool vertical, int notches)
+{
+#ifdef REL_WHEEL_HI_RES
+    write_uinput_event(mouseFileHandler, EV_REL,
+                       vertical ? REL_WHEEL_HI_RES : REL_HWHEEL_HI_RES,
+                       notches * 120, false);
+#endif
+
+    write_uinput_event(mouseFileHandler, EV_REL, vertical ? REL_WHEEL : REL_HWHEEL, notches);
+}
+
+
 void UInputEventHandler::sendMouseEvent(int xDis, int yDis)
 {
+    countOutputEvent();
+
     write_uinput_event(mouseFileHandler, EV_REL, REL_X, xDis, false);
     write_uinput_event(mouseFileHandler, EV_REL, REL_Y, yDis);
 }
 
 
+/**
+ * @brief uinput accepts the full int range for REL events and the hi-res
+ *     wheel axes, so relative output does not need to be capped.
+ */
+bool UInputEventHandler::hasHighResolutionOutput()
+{
+    return true;
+}
+
+
+/**
+ * @brief Scroll by a fraction of a notch. Hi-res wheel events are sent
+ *     when the kernel headers know them. Legacy wheel events are sent
+ *     once a whole notch has accumulated, as real hi-res mice do.
+ * @param Mouse wheel slot
+ * @param Distance in 1/120 of a notch
+ */
+void UInputEventHandler::sendMouseWheelEvent(JoyButtonSlot *slot, int units)
+{
+    int code = slot->getSlotCode();
+
+    if ((slot->getSlotMode() != JoyButtonSlot::JoyMouseButton) ||
+        (code < 4) || (code > 7))
+    {
+        return;
+    }
+
+    countOutputEvent();
+
+    bool vertical = (code == 4) || (code == 5);
+    int value = ((code == 4) || (code == 6)) ? units : -units;
+    int &remainder = vertical ? wheelRemainderY : wheelRemainderX;
+
+    // Drop a partial notch left over from the opposite direction.
+    if ((remainder != 0) && ((remainder > 0) != (value > 0)))
+        remainder = 0;
+
+    remainder += value;
+    int notches = remainder / 120;
+    remainder -= notches * 120;
+
+#ifdef REL_WHEEL_HI_RES
+    write_uinput_event(mouseFileHandler, EV_REL,
+                       vertical ? REL_WHEEL_HI_RES : REL_HWHEEL_HI_RES,
+                       value, notches == 0);
+#endif
+
+    if (notches != 0)
+        write_uinput_event(mouseFileHandler, EV_REL, vertical ? REL_WHEEL : REL_HWHEEL, notches);
+}
+
+
 void UInputEventHandler::sendMouseAbsEvent(int xDis, int yDis, int screen)
 {
     Q_UNUSED(screen);
 
+    countOutputEvent();
+
     write_uinput_event(springMouseFileHandler, EV_ABS, ABS_X, xDis, false);
     write_uinput_event(springMouseFileHandler, EV_ABS, ABS_Y, yDis);
 }
@@ -387,6 +467,10 @@ void UInputEventHandler::setRelMouseEvents(int filehandle)
     ioctl(filehandle, UI_SET_RELBIT, REL_Y);
     ioctl(filehandle, UI_SET_RELBIT, REL_WHEEL);
     ioctl(filehandle, UI_SET_RELBIT, REL_HWHEEL);
+#ifdef REL_WHEEL_HI_RES
+    ioctl(filehandle, UI_SET_RELBIT, REL_WHEEL_HI_RES);
+    ioctl(filehandle, UI_SET_RELBIT, REL_HWHEEL_HI_RES);
+#endif
 
     ioctl(filehandle, UI_SET_KEYBIT, BTN_LEFT);
     ioctl(filehandle, UI_SET_KEYBIT, BTN_RIGHT);
@@ -549,94 +633,138 @@ void UInputEventHandler::printPostMessages()
 
 
 void UInputEventHandler::sendTextEntryEvent(QString maintext)
+{
+    QVector<textEntryStroke> plan;
+
+    if (compileTextEntry(maintext, plan)) sendTextEntryPlan(plan);
+}
+
+
+/**
+ * @brief Resolve every character of the text to a Linux key code and the
+ *     key codes of the modifiers that have to be held for it.
+ */
+bool UInputEventHandler::compileTextEntry(QString maintext, QVector<textEntryStroke> &plan)
 {
     AntKeyMapper *mapper = AntKeyMapper::getInstance();
+    plan.clear();
+
+    if ((mapper == nullptr) || !mapper->getKeyMapper()) return false;
 
-    if ((mapper != nullptr) && mapper->getKeyMapper())
+    QtUInputKeyMapper *keymapper = qobject_cast<QtUInputKeyMapper*>(mapper->getKeyMapper());
+    #ifdef WITH_X11
+    QtX11KeyMapper *nativeWinKeyMapper = nullptr;
+
+    if (mapper->getNativeKeyMapper())
     {
-        QtUInputKeyMapper *keymapper = qobject_cast<QtUInputKeyMapper*>(mapper->getKeyMapper());
-        #ifdef WITH_X11
-        QtX11KeyMapper *nativeWinKeyMapper = nullptr;
+        nativeWinKeyMapper = qobject_cast<QtX11KeyMapper*>(mapper->getNativeKeyMapper());
+    }
+    #endif
 
-        if (mapper->getNativeKeyMapper())
-        {
-            nativeWinKeyMapper = qobject_cast<QtX11KeyMapper*>(mapper->getNativeKeyMapper());
-        }
-        #endif
+    plan.reserve(maintext.size());
 
-        QList<unsigned int> tempList;
+    for (int i = 0; i < maintext.size(); i++)
+    {
+        QtUInputKeyMapper::charKeyInformation temp;
+        temp.virtualkey = 0;
+        temp.modifiers = Qt::NoModifier;
 
-        for (int i = 0; i < maintext.size(); i++)
+        #ifdef WITH_X11
+        if (nativeWinKeyMapper != nullptr)
         {
-            tempList.clear();
-
-            QtUInputKeyMapper::charKeyInformation temp;
-            temp.virtualkey = 0;
-            temp.modifiers = Qt::NoModifier;
+            QtX11KeyMapper::charKeyInformation tempX11 = nativeWinKeyMapper->getCharKeyInformation(maintext.at(i));
+            tempX11.virtualkey = X11Extras::getInstance()->getGroup1KeySym(tempX11.virtualkey);
+            unsigned int tempQtKey = nativeWinKeyMapper->returnQtKey(tempX11.virtualkey);
 
-            #ifdef WITH_X11
-            if (nativeWinKeyMapper != nullptr)
+            if (tempQtKey > 0)
             {
-                QtX11KeyMapper::charKeyInformation tempX11 = nativeWinKeyMapper->getCharKeyInformation(maintext.at(i));
-                tempX11.virtualkey = X11Extras::getInstance()->getGroup1KeySym(tempX11.virtualkey);
-                unsigned int tempQtKey = nativeWinKeyMapper->returnQtKey(tempX11.virtualkey);
-
-                if (tempQtKey > 0)
-                {
-                    temp.virtualkey = keymapper->returnVirtualKey(tempQtKey);
-                    temp.modifiers = tempX11.modifiers;
-                }
-                else
-                {
-                    temp = keymapper->getCharKeyInformation(maintext.at(i));
-                }
+                temp.virtualkey = keymapper->returnVirtualKey(tempQtKey);
+                temp.modifiers = tempX11.modifiers;
             }
             else
             {
-        #endif
                 temp = keymapper->getCharKeyInformation(maintext.at(i));
-        #ifdef WITH_X11
             }
-        #endif
-
-            if (temp.virtualkey > KEY_RESERVED)
-            {
-                if (temp.modifiers != Qt::NoModifier)
-                {
-                    testAndAppend(temp.modifiers.testFlag(Qt::ShiftModifier), tempList, KEY_LEFTSHIFT);
-                    testAndAppend(temp.modifiers.testFlag(Qt::ControlModifier), tempList, KEY_LEFTCTRL);
-                    testAndAppend(temp.modifiers.testFlag(Qt::AltModifier), tempList, KEY_LEFTALT);
-                    testAndAppend(temp.modifiers.testFlag(Qt::MetaModifier), tempList, KEY_LEFTMETA);
-                }
+        }
+        else
+        {
+    #endif
+            temp = keymapper->getCharKeyInformation(maintext.at(i));
+    #ifdef WITH_X11
+        }
+    #endif
 
-                tempList.append(temp.virtualkey);
-                write_uinput_event(keyboardFileHandler, EV_KEY, temp.virtualkey, 1, true);
-            }
+        if (temp.virtualkey > KEY_RESERVED)
+        {
+            textEntryStroke stroke;
+            stroke.keycode = temp.virtualkey;
+            stroke.modifierCount = 0;
 
-            if (tempList.size() > 0)
+            if (temp.modifiers != Qt::NoModifier)
             {
-                QListIterator<unsigned int> tempiter(tempList);
-                tempiter.toBack();
-
-                while (tempiter.hasPrevious())
-                {
-                    unsigned int currentcode = tempiter.previous();
-                    bool sync = !tempiter.hasPrevious() ? true : false;
-                    write_uinput_event(keyboardFileHandler, EV_KEY, currentcode, 0, sync);
-                }
+                testAndAppend(temp.modifiers.testFlag(Qt::ShiftModifier), stroke, KEY_LEFTSHIFT);
+                testAndAppend(temp.modifiers.testFlag(Qt::ControlModifier), stroke, KEY_LEFTCTRL);
+                testAndAppend(temp.modifiers.testFlag(Qt::AltModifier), stroke, KEY_LEFTALT);
+                testAndAppend(temp.modifiers.testFlag(Qt::MetaModifier), stroke, KEY_LEFTMETA);
             }
+
+            plan.append(stroke);
         }
     }
+
+    return true;
 }
 
 
-void UInputEventHandler::testAndAppend(bool tested, QList<unsigned int>& tempList, unsigned int key)
+/**
+ * @brief Type out a compiled text entry with a single write to the keyboard
+ *     device. Every character ends with a sync report.
+ */
+void UInputEventHandler::sendTextEntryPlan(QVector<textEntryStroke> const& plan)
 {
-    if (tested)
+    if (plan.isEmpty()) return;
+
+    QVector<struct input_event> events;
+    // Press and release of the key and up to four modifiers plus two syncs
+    events.reserve(plan.size() * 12);
+
+    struct timeval eventTime;
+    gettimeofday(&eventTime, nullptr);
+
+    auto appendEvent = [&events, &eventTime](int type, int code, int value) {
+        struct input_event ev;
+        memset(&ev, 0, sizeof(struct input_event));
+        ev.time = eventTime;
+        ev.type = type;
+        ev.code = code;
+        ev.value = value;
+        events.append(ev);
+    };
+
+    for (textEntryStroke const& stroke : plan)
     {
-        tempList.append(key);
-        write_uinput_event(keyboardFileHandler, EV_KEY, key, 1, false);
+        countOutputEvent();
+
+        for (int i = 0; i < stroke.modifierCount; i++)
+            appendEvent(EV_KEY, stroke.modifiers[i], 1);
+
+        appendEvent(EV_KEY, stroke.keycode, 1);
+        appendEvent(EV_SYN, SYN_REPORT, 0);
+        appendEvent(EV_KEY, stroke.keycode, 0);
+
+        for (int i = stroke.modifierCount - 1; i >= 0; i--)
+            appendEvent(EV_KEY, stroke.modifiers[i], 0);
+
+        appendEvent(EV_SYN, SYN_REPORT, 0);
     }
+
+    write(keyboardFileHandler, events.constData(), events.size() * sizeof(struct input_event));
+}
+
+
+void UInputEventHandler::testAndAppend(bool tested, textEntryStroke &stroke, unsigned int key)
+{
+    if (tested) stroke.modifiers[stroke.modifierCount++] = key;
 }
 
 
@@ -45,6 +45,11 @@ public:
     virtual void printPostMessages() override;
 
     virtual void sendTextEntryEvent(QString maintext) override;
+    virtual bool compileTextEntry(QString maintext, QVector<textEntryStroke> &plan) override;
+    virtual void sendTextEntryPlan(QVector<textEntryStroke> const& plan) override;
+
+    virtual bool hasHighResolutionOutput() override;
+    virtual void sendMouseWheelEvent(JoyButtonSlot *slot, int units) override;
 
     int getKeyboardFileHandler();
     int getMouseFileHandler();
@@ -63,6 +68,7 @@ protected:
     void closeUInputDevice(int filehandle);
     void write_uinput_event(int filehandle, int type,
                             int code, int value, bool syn=true);
+    void writeWheelNotches(bool vertical, int notches);
 
 private slots:
 #ifdef WITH_X11
@@ -75,8 +81,12 @@ private:
     int springMouseFileHandler;
     QString uinputDeviceLocation;
 
+    // Wheel distance in 1/120 of a notch not yet sent as a whole notch
+    int wheelRemainderX;
+    int wheelRemainderY;
+
     bool cleanupUinputEvHand();
-    void testAndAppend(bool tested, QList<unsigned int>& tempList, unsigned int key);
+    void testAndAppend(bool tested, textEntryStroke &stroke, unsigned int key);
     void initDevice(int& device, QString name, bool& result);
 
 };
@@ -23,6 +23,8 @@
 #include "antkeymapper.h"
 #include "messagehandler.h"
 
+#include <QElapsedTimer>
+
 #include <X11/Xlib.h>
 #include <X11/Xutil.h>
 #include <X11/extensions/XTest.h>
@@ -30,8 +32,17 @@
 #include "x11extras.h"
 
 
+// X11Extras opens one display connection per thread. Output frames and the
+// mapping check follow the connection of the thread, so they are kept per
+// thread as well.
+static thread_local int outputFrameDepth = 0;
+static thread_local bool outputFlushPending = false;
+static thread_local QElapsedTimer mappingCheckTime;
+
+
 XTestEventHandler::XTestEventHandler(QObject *parent) :
-    BaseEventHandler(parent)
+    BaseEventHandler(parent),
+    mappingGeneration(0)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 }
@@ -78,12 +89,13 @@ void XTestEventHandler::sendKeyboardEvent(JoyButtonSlot *slot, bool pressed)
 
     if (device == JoyButtonSlot::JoyKeyboard)
     {
-        int tempcode = XKeysymToKeycode(display, static_cast<KeySym>(code));
+        int tempcode = keysymToKeycode(static_cast<KeySym>(code));
 
         if (tempcode > 0)
         {
+            countOutputEvent();
             XTestFakeKeyEvent(display, tempcode, pressed, 0);
-            XFlush(display);
+            flushOutput();
         }
     }
 }
@@ -100,8 +112,9 @@ void XTestEventHandler::sendMouseButtonEvent(JoyButtonSlot *slot, bool pressed)
 
     if (device == JoyButtonSlot::JoyMouseButton)
     {
+        countOutputEvent();
         XTestFakeButtonEvent(display, code, pressed, 0);
-        XFlush(display);
+        flushOutput();
     }
 }
 
@@ -110,9 +123,11 @@ void XTestEventHandler::sendMouseEvent(int xDis, int yDis)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
+    countOutputEvent();
+
     Display* display = X11Extras::getInstance()->display();
     XTestFakeRelativeMotionEvent(display, xDis, yDis, 0);
-    XFlush(display);
+    flushOutput();
 }
 
 
@@ -120,9 +135,11 @@ void XTestEventHandler::sendMouseAbsEvent(int xDis, int yDis, int screen)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
+    countOutputEvent();
+
     Display* display = X11Extras::getInstance()->display();
     XTestFakeMotionEvent(display, screen, xDis, yDis, 0);
-    XFlush(display);
+    flushOutput();
 }
 
 
@@ -146,73 +163,171 @@ void XTestEventHandler::sendTextEntryEvent(QString maintext)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
+    QVector<textEntryStroke> plan;
+
+    if (compileTextEntry(maintext, plan)) sendTextEntryPlan(plan);
+}
+
+
+/**
+ * @brief Resolve every character of the text to an X keycode and the
+ *     keycodes of the modifiers that have to be held for it.
+ */
+bool XTestEventHandler::compileTextEntry(QString maintext, QVector<textEntryStroke> &plan)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
     AntKeyMapper *mapper = AntKeyMapper::getInstance();
+    plan.clear();
+
+    if ((mapper == nullptr) || !mapper->getKeyMapper()) return false;
+
+    QtX11KeyMapper *keymapper = qobject_cast<QtX11KeyMapper*>(mapper->getKeyMapper());
+    plan.reserve(maintext.size());
 
-    if ((mapper != nullptr) && mapper->getKeyMapper())
+    for (int i = 0; i < maintext.size(); i++)
     {
-        Display* display = X11Extras::getInstance()->display();
-        QtX11KeyMapper *keymapper = qobject_cast<QtX11KeyMapper*>(mapper->getKeyMapper());
+        QtX11KeyMapper::charKeyInformation temp = keymapper->getCharKeyInformation(maintext.at(i));
+        int tempcode = keysymToKeycode(static_cast<KeySym>(temp.virtualkey));
 
-        for (int i = 0; i < maintext.size(); i++)
+        if (tempcode > 0)
         {
-            QtX11KeyMapper::charKeyInformation temp = keymapper->getCharKeyInformation(maintext.at(i));
-            int tempcode = XKeysymToKeycode(display, static_cast<KeySym>(temp.virtualkey));
+            textEntryStroke stroke;
+            stroke.keycode = static_cast<unsigned int>(tempcode);
+            stroke.modifierCount = 0;
 
-            if (tempcode > 0)
+            if (temp.modifiers != Qt::NoModifier)
             {
-                QList<int> tempList;
-
-                if ((temp.modifiers != Qt::NoModifier) && temp.modifiers.testFlag(Qt::ShiftModifier))
-                {
-                  int shiftcode = XKeysymToKeycode(display, XK_Shift_L);
-                  int modifiercode = shiftcode;
-                  XTestFakeKeyEvent(display, modifiercode, 1, 0);
-                  tempList.append(modifiercode);
-                }
-
-                if ((temp.modifiers != Qt::NoModifier) && temp.modifiers.testFlag(Qt::ControlModifier))
-                {
-                  int controlcode = XKeysymToKeycode(display, XK_Control_L);
-                  int modifiercode = controlcode;
-                  XTestFakeKeyEvent(display, modifiercode, 1, 0);
-                  tempList.append(modifiercode);
-                }
-
-                if ((temp.modifiers != Qt::NoModifier) && temp.modifiers.testFlag(Qt::AltModifier))
-                {
-                  int altcode = XKeysymToKeycode(display, XK_Alt_L);
-                  int modifiercode = altcode;
-                  XTestFakeKeyEvent(display, modifiercode, 1, 0);
-                  tempList.append(modifiercode);
-                }
-
-                if ((temp.modifiers != Qt::NoModifier) && temp.modifiers.testFlag(Qt::MetaModifier))
-                {
-                  int metacode = XKeysymToKeycode(display, XK_Meta_L);
-                  int modifiercode = metacode;
-                  XTestFakeKeyEvent(display, modifiercode, 1, 0);
-                  tempList.append(modifiercode);
-                }
-
-                XTestFakeKeyEvent(display, tempcode, 1, 0);
-                tempList.append(tempcode);
-
-                XFlush(display);
-
-                if (tempList.size() > 0)
-                {
-                    QListIterator<int> tempiter(tempList);
-                    tempiter.toBack();
-
-                    while (tempiter.hasPrevious())
-                    {
-                        int currentcode = tempiter.previous();
-                        XTestFakeKeyEvent(display, currentcode, 0, 0);
-                    }
-
-                    XFlush(display);
-                }
+                if (temp.modifiers.testFlag(Qt::ShiftModifier))
+                    stroke.modifiers[stroke.modifierCount++] = static_cast<unsigned int>(keysymToKeycode(XK_Shift_L));
+
+                if (temp.modifiers.testFlag(Qt::ControlModifier))
+                    stroke.modifiers[stroke.modifierCount++] = static_cast<unsigned int>(keysymToKeycode(XK_Control_L));
+
+                if (temp.modifiers.testFlag(Qt::AltModifier))
+                    stroke.modifiers[stroke.modifierCount++] = static_cast<unsigned int>(keysymToKeycode(XK_Alt_L));
+
+                if (temp.modifiers.testFlag(Qt::MetaModifier))
+                    stroke.modifiers[stroke.modifierCount++] = static_cast<unsigned int>(keysymToKeycode(XK_Meta_L));
             }
+
+            plan.append(stroke);
+        }
+    }
+
+    return true;
+}
+
+
+void XTestEventHandler::sendTextEntryPlan(QVector<textEntryStroke> const& plan)
+{
+    Display* display = X11Extras::getInstance()->display();
+
+    for (textEntryStroke const& stroke : plan)
+    {
+        countOutputEvent();
+
+        for (int i = 0; i < stroke.modifierCount; i++)
+            XTestFakeKeyEvent(display, stroke.modifiers[i], 1, 0);
+
+        XTestFakeKeyEvent(display, stroke.keycode, 1, 0);
+        XTestFakeKeyEvent(display, stroke.keycode, 0, 0);
+
+        for (int i = stroke.modifierCount - 1; i >= 0; i--)
+            XTestFakeKeyEvent(display, stroke.modifiers[i], 0, 0);
+    }
+
+    // Requests reach the server in order so the whole text can
+    // go out with a single flush.
+    flushOutput();
+}
+
+
+int XTestEventHandler::getKeyMappingGeneration()
+{
+    return mappingGeneration.loadAcquire();
+}
+
+
+void XTestEventHandler::beginOutputFrame()
+{
+    if (outputFrameDepth++ == 0)
+        checkMappingChanges();
+}
+
+
+void XTestEventHandler::endOutputFrame()
+{
+    if ((--outputFrameDepth == 0) && outputFlushPending)
+    {
+        outputFlushPending = false;
+        XFlush(X11Extras::getInstance()->display());
+    }
+}
+
+
+/**
+ * @brief Send queued fake events to the X server. Inside an output frame the
+ *     flush is postponed until the outermost frame ends so one input pass
+ *     or mouse tick costs a single flush.
+ */
+void XTestEventHandler::flushOutput()
+{
+    // Every thread sends its events through its own display connection,
+    // so this only flushes output of the calling thread. Other threads
+    // flush their connection when their own frame ends.
+    if (outputFrameDepth > 0)
+        outputFlushPending = true;
+    else XFlush(X11Extras::getInstance()->display());
+}
+
+
+int XTestEventHandler::keysymToKeycode(unsigned long keysym)
+{
+    QMutexLocker locker(&keycodeCacheMutex);
+
+    QHash<unsigned long, int>::const_iterator iter = keycodeCache.constFind(keysym);
+
+    if (iter != keycodeCache.constEnd()) return iter.value();
+
+    int keycode = XKeysymToKeycode(X11Extras::getInstance()->display(), static_cast<KeySym>(keysym));
+    keycodeCache.insert(keysym, keycode);
+
+    return keycode;
+}
+
+
+/**
+ * @brief Pick up MappingNotify events without a round trip and drop cached
+ *     keycodes when the keyboard mapping changed. Every connection gets
+ *     its own MappingNotify events, so each thread checks the connection
+ *     it sends through. Nothing else reads events from these connections.
+ */
+void XTestEventHandler::checkMappingChanges()
+{
+    if (mappingCheckTime.isValid() && !mappingCheckTime.hasExpired(MAPPINGCHECKINTERVAL)) return;
+
+    mappingCheckTime.start();
+
+    Display* display = X11Extras::getInstance()->display();
+
+    if (XEventsQueued(display, QueuedAfterReading) > 0)
+    {
+        XEvent event;
+        bool keyboardChanged = false;
+
+        while (XCheckTypedEvent(display, MappingNotify, &event))
+        {
+            XRefreshKeyboardMapping(&event.xmapping);
+
+            if (event.xmapping.request != MappingPointer) keyboardChanged = true;
+        }
+
+        if (keyboardChanged)
+        {
+            QMutexLocker locker(&keycodeCacheMutex);
+            keycodeCache.clear();
+            mappingGeneration.fetchAndAddOrdered(1);
         }
     }
 }
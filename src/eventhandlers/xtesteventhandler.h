@@ -22,6 +22,10 @@
 
 #include "baseeventhandler.h"
 
+#include <QHash>
+#include <QMutex>
+#include <QAtomicInt>
+
 
 class JoyButtonSlot;
 
@@ -47,11 +51,30 @@ public:
     void sendMouseSpringEvent(int xDis, int yDis) override;
 
     void sendTextEntryEvent(QString maintext) override;
+    bool compileTextEntry(QString maintext, QVector<textEntryStroke> &plan) override;
+    void sendTextEntryPlan(QVector<textEntryStroke> const& plan) override;
+    int getKeyMappingGeneration() override;
+
+    void beginOutputFrame() override;
+    void endOutputFrame() override;
 
     QString getName() override;
     QString getIdentifier() override;
     void printPostMessages() override;
 
+    // Minimum time in ms between checks for keyboard mapping changes.
+    static const int MAPPINGCHECKINTERVAL = 250;
+
+private:
+    int keysymToKeycode(unsigned long keysym);
+    void flushOutput();
+    void checkMappingChanges();
+
+    // Keycodes resolved for the current keyboard mapping. Emptied when a
+    // MappingNotify event arrives.
+    QHash<unsigned long, int> keycodeCache;
+    QMutex keycodeCacheMutex;
+    QAtomicInt mappingGeneration;
 };
 
 #endif // XTESTEVENTHANDLER_H
@@ -0,0 +1,93 @@
+/* antimicroX Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ * Copyright (C) 2020 Jagoda Górska <juliagoda.pl@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef FIXEDCAPACITYLIST_H
+#define FIXEDCAPACITYLIST_H
+
+#include <QtGlobal>
+
+/**
+ * @brief List with storage for a fixed number of elements embedded in the
+ *     object. Nothing is allocated after construction; append() refuses
+ *     elements once the list is full.
+ */
+template <typename T, int Capacity>
+class FixedCapacityList
+{
+public:
+    FixedCapacityList() :
+        used(0)
+    {
+    }
+
+    bool append(const T& value)
+    {
+        if (used >= Capacity)
+            return false;
+
+        items[used++] = value;
+        return true;
+    }
+
+    void removeAt(int index)
+    {
+        Q_ASSERT((index >= 0) && (index < used));
+
+        for (int i = index; i < (used - 1); i++)
+        {
+            items[i] = items[i + 1];
+        }
+
+        used--;
+    }
+
+    const T& at(int index) const
+    {
+        Q_ASSERT((index >= 0) && (index < used));
+        return items[index];
+    }
+
+    int length() const
+    {
+        return used;
+    }
+
+    bool isEmpty() const
+    {
+        return used == 0;
+    }
+
+    void clear()
+    {
+        used = 0;
+    }
+
+    static int capacity()
+    {
+        return Capacity;
+    }
+
+private:
+    Q_DISABLE_COPY(FixedCapacityList)
+
+    T items[Capacity];
+    int used;
+};
+
+#endif // FIXEDCAPACITYLIST_H
@@ -253,6 +253,11 @@ void GameController::setCounterUniques(int counter)
     counterUniques = counter;
 }
 
+int GameController::getCounterUniques() const
+{
+    return counterUniques;
+}
+
 
 void GameController::fillContainers(QHash<int, SDL_GameControllerButton> &buttons, QHash<int, SDL_GameControllerAxis> &axes, QList<SDL_GameControllerButtonBind> &hatButtons)
 {
@@ -60,6 +60,7 @@ public:
     virtual int getNumberRawAxes() override;
     virtual int getNumberRawHats() override;
     void setCounterUniques(int counter) override;
+    int getCounterUniques() const;
 
     QString getBindStringForAxis(int index, bool trueIndex=true);
     QString getBindStringForButton(int index, bool trueIndex=true);
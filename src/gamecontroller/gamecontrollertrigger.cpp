@@ -64,6 +64,11 @@ void GameControllerTrigger::reset()
     eventActive = false;
     maxZoneValue = GlobalVariables::GameControllerTrigger::AXISMAXZONE;
     throttle = this->DEFAULTTHROTTLE;
+    outputCurve.clear();
+
+    outputCurveTableMutex.lock();
+    outputCurveTable.clear();
+    outputCurveTableMutex.unlock();
 
     paxisbutton->reset();
     naxisbutton->reset();
@@ -20,6 +20,8 @@
 #include "gamecontroller/gamecontrollertriggerbutton.h"
 #include "xml/joyaxisxml.h"
 #include "xml/joybuttonxml.h"
+#include "xml/responsecurvexml.h"
+#include "responsecurve.h"
 
 #include "messagehandler.h"
 
@@ -110,6 +112,14 @@ void GameControllerTriggerXml::writeConfig(QXmlStreamWriter *xml)
         xml->writeTextElement("maxZone", QString::number(m_gameContrTrigger->getMaxZoneValue()));
     }
 
+    ResponseCurve outputCurve = m_gameContrTrigger->getOutputCurve();
+
+    if (!currentlyDefault && !outputCurve.isEmpty())
+    {
+        ResponseCurveXml curveXml(&outputCurve);
+        curveXml.writeConfig(xml, "outputcurve");
+    }
+
     xml->writeStartElement("throttle");
 
         switch(m_gameContrTrigger->getThrottle())
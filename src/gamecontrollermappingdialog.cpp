@@ -22,6 +22,7 @@
 #include "messagehandler.h"
 #include "inputdevice.h"
 #include "antimicrosettings.h"
+#include "deviceregistry.h"
 #include "common.h"
 
 #include <QDebug>
@@ -341,17 +342,19 @@ void GameControllerMappingDialog::saveChanges()
 
     QString mappingString = generateSDLMappingString();
 
-    settings->getLock()->lock();
-//    settings->setValue(QString("Mappings/").append(device->getGUIDString()), mappingString);
-//    settings->setValue(QString("Mappings/%1%2").arg(device->getGUIDString()).arg("Disable"), "0");
+    // Looking the device up first moves settings stored under the plain
+    // GUID by older versions to the unique ID.
+    DeviceRegistry::deviceRegistryEntry entry;
+    DeviceRegistry::getInstance()->lookup(device->getGUIDString(), device->getUniqueIDString(), entry);
+    DeviceRegistry::getInstance()->setMapping(device->getUniqueIDString(), mappingString);
+    DeviceRegistry::getInstance()->setGameControllerDisabled(device->getUniqueIDString(), false);
 
-    device->convertToUniqueMappSett(settings, QString("Mappings/").append(device->getGUIDString()), QString("Mappings/").append(device->getUniqueIDString()));
-    device->convertToUniqueMappSett(settings, QString("Mappings/%1%2").arg(device->getGUIDString()).arg("Disable"), QString("Mappings/%1%2").arg(device->getUniqueIDString()).arg("Disable"));
+    // Store the mapping in the file right away like before instead of
+    // waiting for the queued write of the registry
+    DeviceRegistry::getInstance()->flush();
 
-    settings->setValue(QString("Mappings/").append(device->getUniqueIDString()), mappingString);
-    settings->setValue(QString("Mappings/%1%2").arg(device->getUniqueIDString()).arg("Disable"), "0");
+    settings->getLock()->lock();
     settings->sync();
-
     bool displayMapping = settings->runtimeValue("DisplaySDLMapping", false).toBool();
     settings->getLock()->unlock();
 
@@ -506,17 +509,7 @@ void GameControllerMappingDialog::removeControllerMapping()
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
-    settings->getLock()->lock();
-
-    settings->beginGroup("Mappings");
-    //settings->remove(device->getGUIDString());
-    settings->remove(device->getUniqueIDString());
-    //settings->remove(QString("%1Disable").arg(device->getGUIDString()));
-    settings->remove(QString("%1Disable").arg(device->getUniqueIDString()));
-    settings->endGroup();
-    settings->sync();
-
-    settings->getLock()->unlock();
+    DeviceRegistry::getInstance()->removeMapping(device->getUniqueIDString());
 }
 
 void GameControllerMappingDialog::enableDeviceConnections()
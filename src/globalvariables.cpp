@@ -79,6 +79,12 @@ QList<double> GlobalVariables::JoyButton::mouseHistoryY;
 double GlobalVariables::JoyButton::cursorRemainderX = 0.0;
 double GlobalVariables::JoyButton::cursorRemainderY = 0.0;
 
+// Fixed-point carry of a cursor move used instead of the remainder above
+// when high resolution output is active.
+qint64 GlobalVariables::JoyButton::cursorSubPixelX = 0;
+qint64 GlobalVariables::JoyButton::cursorSubPixelY = 0;
+bool GlobalVariables::JoyButton::highResolutionMouse = false;
+
 double GlobalVariables::JoyButton::weightModifier = 0;
 // Mouse history buffer size
 int GlobalVariables::JoyButton::mouseHistorySize = 1;
@@ -128,6 +134,9 @@ const QString GlobalVariables::X11Extras::mouseDeviceName = PadderCommon::mouseD
 const QString GlobalVariables::X11Extras::keyboardDeviceName = PadderCommon::keyboardDeviceName;
 const QString GlobalVariables::X11Extras::xtestMouseDeviceName = QString("Virtual core XTEST pointer");
 
+const int GlobalVariables::X11Extras::PIDCACHEREVALIDATETIME = 2000;
+const int GlobalVariables::X11Extras::PIDCACHESIZE = 32;
+
 QString GlobalVariables::X11Extras::_customDisplayString = QString("");
 
     #endif
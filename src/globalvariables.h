@@ -42,6 +42,10 @@ namespace GlobalVariables
 
       static double cursorRemainderX;
       static double cursorRemainderY;
+      // Sub-pixel cursor position in high resolution mode
+      static qint64 cursorSubPixelX;
+      static qint64 cursorSubPixelY;
+      static bool highResolutionMouse;
       static double mouseSpeedModifier;
       // Weight modifier in the range of 0.0 - 1.0
       static double weightModifier;
@@ -140,6 +144,11 @@ namespace GlobalVariables
       static const QString keyboardDeviceName;
       static const QString xtestMouseDeviceName;
 
+      // Time in ms during which a cached pid location is trusted
+      // without checking /proc again
+      static const int PIDCACHEREVALIDATETIME;
+      static const int PIDCACHESIZE;
+
       static QString _customDisplayString;
   };
 
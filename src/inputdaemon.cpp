@@ -27,14 +27,16 @@
 #include "sdleventreader.h"
 #include "antimicrosettings.h"
 #include "inputdevicebitarraystatus.h"
+#include "eventhandlerfactory.h"
+#include "deviceregistry.h"
 
 
 #include <QDebug>
 #include <QTime>
 #include <QTimer>
-#include <QEventLoop>
 #include <QMapIterator>
 #include <QThread>
+#include <QSet>
 
 #define USE_NEW_REFRESH
 
@@ -51,8 +53,12 @@ InputDaemon::InputDaemon(QMap<SDL_JoystickID, InputDevice*> *joysticks,
     //xbox360 = xbox360class->getResult();
     this->stopped = false;
     m_graphical = graphical;
+    inputPass = 0;
     m_settings = settings;
 
+    // Loaded before SDL starts, which takes the mappings from it.
+    DeviceRegistry::getInstance()->load(settings);
+
     eventWorker = new SDLEventReader(joysticks, settings);
     refreshJoysticks();
     sdlWorkerThread = nullptr;
@@ -122,10 +128,19 @@ void InputDaemon::run ()
         JoyButton::resetActiveButtonMouseDistances(JoyButton::getMouseHelper());
 
         QQueue<SDL_Event> sdlEventQueue;
+
+        // Zero is the initial value of every axis pass stamp.
+        if (++inputPass == 0) inputPass = 1;
+
+        BaseEventHandler *handler = EventHandlerFactory::getInstance()->handler();
+        handler->beginOutputFrame();
+
         firstInputPass(&sdlEventQueue);
         modifyUnplugEvents(&sdlEventQueue);
         secondInputPass(&sdlEventQueue);
         clearBitArrayStatusInstances();
+
+        handler->endOutputFrame();
     }
 
     if (stopped)
@@ -183,13 +198,6 @@ void InputDaemon::refreshJoysticks()
     getTrackjoysticksLocal().clear();
     trackcontrollers.clear();
 
-    m_settings->getLock()->lock();
-    m_settings->beginGroup("Mappings");
-
-    QMap<QString,int> uniques = QMap<QString,int>();
-    int counterUniques = 1;
-    bool duplicatedGamepad = false;
-
     for (int i = 0; i < SDL_NumJoysticks(); i++)
     {
 #ifdef USE_NEW_REFRESH
@@ -213,33 +221,17 @@ void InputDaemon::refreshJoysticks()
 
                     QString vendor = getJoyInfo(SDL_GameControllerGetVendor(controller));
 
-                    QString productID = getJoyInfo(SDL_GameControllerGetProduct(controller));
-
-                    if (uniques.contains(guidText))
-                    {
-                        productID = getJoyInfo(SDL_GameControllerGetProduct(controller) + ++uniques[guidText]);
-                        duplicatedGamepad = true;
-
-                        // previous value will be erased in map anyway
-                        uniques.insert(guidText, uniques[guidText]);
-                    }
-                    else
-                    {
-                        uniques.insert(guidText, counterUniques);
-                    }
+                    int resultDuplicated = duplicateCounterFor(guidText);
 
-                    convertMappingsToUnique(m_settings, guidText, guidText + vendor + productID);
+                    QString productID = getJoyInfo(SDL_GameControllerGetProduct(controller) + resultDuplicated);
 
-                    bool disableGameController = m_settings->value(QString("%1Disable").arg(guidText + vendor + productID), false).toBool();
+                    DeviceRegistry::deviceRegistryEntry entry;
+                    DeviceRegistry::getInstance()->lookup(guidText, guidText + vendor + productID, entry);
 
                     // Check if user has designated device Joystick mode.
-                    if (!disableGameController)
+                    if (!entry.disableGameController)
                     {
-                        int resultDuplicated = 0;
-                        if (duplicatedGamepad) resultDuplicated = uniques.value(guidText);
-
                         GameController *damncontroller = new GameController(controller, index, m_settings, resultDuplicated, this);
-                        duplicatedGamepad = false;
                         connect(damncontroller, &GameController::requestWait, eventWorker, &SDLEventReader::haltServices);
                         m_joysticks->insert(tempJoystickID, damncontroller);
                         trackcontrollers.insert(tempJoystickID, damncontroller);
@@ -279,9 +271,10 @@ void InputDaemon::refreshJoysticks()
             SDL_JoystickGetGUIDString(tempGUID, guidString, sizeof(guidString));
             temp = QString(guidString);
 
-            bool disableGameController = m_settings->value(QString("%1Disable").arg(temp), false).toBool();
+            DeviceRegistry::deviceRegistryEntry entry;
+            DeviceRegistry::getInstance()->lookup(temp, temp, entry);
 
-            if (SDL_IsGameController(i) && !disableGameController)
+            if (SDL_IsGameController(i) && !entry.disableGameController)
             {
                 SDL_GameController *controller = SDL_GameControllerOpen(i);
                 GameController *damncontroller = new GameController(controller, i, m_settings, this);
@@ -303,9 +296,6 @@ void InputDaemon::refreshJoysticks()
 #endif
     }
 
-    m_settings->endGroup();
-    m_settings->getLock()->unlock();
-
     emit joysticksRefreshed(m_joysticks);
 }
 
@@ -344,37 +334,54 @@ void InputDaemon::stop()
     pollResetTimer.stop();
 }
 
+/**
+ * @brief Bring the device list in line with what SDL reports without
+ *     touching devices that are still connected. Mappings are reloaded
+ *     first so newly mapped pads open as game controllers. Devices that
+ *     are gone and devices that are new go through the same removeDevice
+ *     and addInputDevice paths used for hotplug events.
+ */
 void InputDaemon::refresh()
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
-    qDebug() << "REFRESH";
-
-    stop();
 
     Logger::LogInfo("Refreshing joystick list");
 
-    QEventLoop q;
-    connect(eventWorker, &SDLEventReader::sdlStarted, &q, &QEventLoop::quit);
-    QTimer::singleShot(0, eventWorker, SLOT(refresh()));
-    //QMetaObject::invokeMethod(eventWorker, "refresh", Qt::BlockingQueuedConnection);
+    // Same lock as a regular input pass, which handles hotplug events.
+    PadderCommon::inputDaemonMutex.lock();
 
-    if (eventWorker->isSDLOpen()) q.exec();
+    eventWorker->loadMappings();
 
-    disconnect(eventWorker, &SDLEventReader::sdlStarted, &q, &QEventLoop::quit);
+    QSet<SDL_JoystickID> connectedIDs;
 
-    pollResetTimer.stop();
+    for (int i = 0; i < SDL_NumJoysticks(); i++)
+        connectedIDs.insert(SDL_JoystickGetDeviceInstanceID(i));
 
-    // Put in an extra delay before refreshing the joysticks
-    QTimer temp;
-    connect(&temp, &QTimer::timeout, &q, &QEventLoop::quit);
-    temp.start(100);
-    q.exec();
+    QList<InputDevice*> removedDevices;
+    QMapIterator<SDL_JoystickID, InputDevice*> iter(*m_joysticks);
 
-    refreshJoysticks();
-    QTimer::singleShot(100, eventWorker, SLOT(performWork()));
+    while (iter.hasNext())
+    {
+        iter.next();
+
+        if (!connectedIDs.contains(iter.key()))
+            removedDevices.append(iter.value());
+    }
+
+    for (InputDevice *device : removedDevices)
+    {
+        removeDevice(device);
+    }
 
-    stopped = false;
+    for (int i = 0; i < SDL_NumJoysticks(); i++)
+    {
+        if (!m_joysticks->contains(SDL_JoystickGetDeviceInstanceID(i)))
+            addInputDevice(i);
+    }
 
+    refreshIndexes();
+
+    PadderCommon::inputDaemonMutex.unlock();
 }
 
 void InputDaemon::refreshJoystick(InputDevice *joystick)
@@ -420,10 +427,6 @@ void InputDaemon::refreshMapping(QString mapping, InputDevice *device)
 
     bool found = false;
 
-    QMap<QString,int> uniques = QMap<QString,int>();
-    int counterUniques = 1;
-    bool duplicatedGamepad = false;
-
     for (int i = 0; (i < SDL_NumJoysticks()) && !found; i++)
    // for (int i = 0; (i < 1) && !found; i++)
     {
@@ -458,25 +461,9 @@ void InputDaemon::refreshMapping(QString mapping, InputDevice *device)
                     SDL_GameController *controller = SDL_GameControllerOpen(i);
 
                     QString guidText = getJoyInfo(SDL_JoystickGetGUID(SDL_GameControllerGetJoystick(controller)));
-
-                    if (uniques.contains(guidText))
-                    {
-                        ++uniques[guidText];
-                        duplicatedGamepad = true;
-
-                        // previous value will be erased in map anyway
-                        uniques.insert(guidText, uniques[guidText]);
-                    }
-                    else
-                    {
-                        uniques.insert(guidText, counterUniques);
-                    }
-
-                    int resultDuplicated = 0;
-                    if (duplicatedGamepad) resultDuplicated = counterUniques;
+                    int resultDuplicated = duplicateCounterFor(guidText);
 
                     GameController *damncontroller = new GameController(controller, i, m_settings, resultDuplicated, this);
-                    duplicatedGamepad = false;
                     connect(damncontroller, &GameController::requestWait, eventWorker, &SDLEventReader::haltServices);
                     SDL_Joystick *sdlStick = SDL_GameControllerGetJoystick(controller);
                     joystickID = SDL_JoystickInstanceID(sdlStick);
@@ -515,12 +502,10 @@ void InputDaemon::refreshIndexes()
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
     for (int i = 0; i < SDL_NumJoysticks(); i++)
-    //for (int i = 0; i < 1; i++)
     {
-        SDL_Joystick *joystick = SDL_JoystickOpen(i);
-       // SDL_Joystick *joystick = xbox360;
-        SDL_JoystickID joystickID = SDL_JoystickInstanceID(joystick);
-        SDL_JoystickClose(joystick); // Make sure to decrement reference count
+        // Look the ID up without opening the device so other pads are
+        // not touched.
+        SDL_JoystickID joystickID = SDL_JoystickGetDeviceInstanceID(i);
         InputDevice *tempdevice = m_joysticks->value(joystickID);
 
         if (tempdevice != nullptr)
@@ -529,7 +514,7 @@ void InputDaemon::refreshIndexes()
     }
 }
 
-void InputDaemon::addInputDevice(int index, QMap<QString,int>& uniques, int& counterUniques, bool& duplicatedGamepad)
+void InputDaemon::addInputDevice(int index)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
@@ -546,22 +531,13 @@ void InputDaemon::addInputDevice(int index, QMap<QString,int>& uniques, int& cou
             // Check if device has already been grabbed.
             if (!m_joysticks->contains(tempJoystickID))
             {
-                m_settings->getLock()->lock();
-                m_settings->beginGroup("Mappings");
-
-                QString temp = QString();
-                SDL_JoystickGUID tempGUID = SDL_JoystickGetGUID(sdlStick);
-                char guidString[65] = {'0'};
-                SDL_JoystickGetGUIDString(tempGUID, guidString, sizeof(guidString));
-                temp = QString(guidString);
+                QString temp = getJoyInfo(SDL_JoystickGetGUID(sdlStick));
 
-                bool disableGameController = m_settings->value(QString("%1Disable").arg(temp), false).toBool();
-
-                m_settings->endGroup();
-                m_settings->getLock()->unlock();
+                DeviceRegistry::deviceRegistryEntry entry;
+                DeviceRegistry::getInstance()->lookup(temp, temp, entry);
 
                 // Check if user has designated device Joystick mode.
-                if (!disableGameController)
+                if (!entry.disableGameController)
                 {
                     GameController *damncontroller = new GameController(controller, index, m_settings, this);
                     connect(damncontroller, &GameController::requestWait, eventWorker, &SDLEventReader::haltServices);
@@ -610,77 +586,33 @@ void InputDaemon::addInputDevice(int index, QMap<QString,int>& uniques, int& cou
         }
     }
 #else
-    SDL_GameController *controller = SDL_GameControllerOpen(index);
     SDL_Joystick *joystick = SDL_JoystickOpen(index);
 
-   // SDL_Joystick *joystick = xbox360;
-   // SDL_GameController *controller = SDL_GameControllerFromInstanceID(xbox360->instance_id);
-
     if (joystick != nullptr)
     {
         SDL_JoystickID tempJoystickID_local = SDL_JoystickInstanceID(joystick);
 
         if (!m_joysticks->contains(tempJoystickID_local))
         {
-            m_settings->getLock()->lock();
-            m_settings->beginGroup("Mappings");
-
-//            QString temp = QString();
-//            SDL_JoystickGUID tempGUID = SDL_JoystickGetGUID(joystick);
-//            char guidString[65] = {'0'};
-//            SDL_JoystickGetGUIDString(tempGUID, guidString, sizeof(guidString));
-//            temp = QString(guidString);
-
-//            bool disableGameController = m_settings->value(QString("%1Disable").arg(temp), false).toBool();
-
-            QString guidText = QString();
-
-            SDL_JoystickGUID tempGUID = SDL_JoystickGetGUID(joystick);
-            char guidString[65] = {'0'};
-            SDL_JoystickGetGUIDString(tempGUID, guidString, sizeof(guidString));
-            guidText = QString(guidString);
-
+            bool isGameController = SDL_IsGameController(index);
+            QString guidText = getJoyInfo(SDL_JoystickGetGUID(joystick));
             QString vendor = QString();
-
-            if (controller != nullptr)
-            {
-                    Uint16 tempVendor = SDL_GameControllerGetVendor(controller);
-                    char buffer [50];
-                    sprintf (buffer, "%u", tempVendor);
-
-                    vendor = QString(buffer);
-            }
-
             QString productID = QString();
+            int resultDuplicated = 0;
 
-            if (controller != nullptr)
-            {
-                    Uint16 tempProduct = SDL_GameControllerGetProduct(controller);
-                    char buffer [50];
-                    sprintf (buffer, "%u", tempProduct);
-
-                    productID = QString(buffer);
-            }
-
-            if (uniques.contains(guidText))
-            {
-                productID = getJoyInfo(SDL_GameControllerGetProduct(controller) + ++uniques[guidText]);
-                duplicatedGamepad = true;
-                uniques.insert(guidText, uniques[guidText]);
-            }
-            else
+            if (isGameController)
             {
-                uniques.insert(guidText, counterUniques);
+                // Number duplicates against the pads already connected so
+                // their unique IDs and profiles stay as they are.
+                resultDuplicated = duplicateCounterFor(guidText);
+                vendor = getJoyInfo(SDL_JoystickGetVendor(joystick));
+                productID = getJoyInfo(SDL_JoystickGetProduct(joystick) + resultDuplicated);
             }
 
-            convertMappingsToUnique(m_settings, guidText, guidText + vendor + productID);
-
-            int resultDuplicated = 0;
-            if (duplicatedGamepad) resultDuplicated = uniques[guidText];
-
-            bool disableGameController = m_settings->value(QString("%1Disable").arg(guidText + vendor + productID), false).toBool();
+            DeviceRegistry::deviceRegistryEntry entry;
+            DeviceRegistry::getInstance()->lookup(guidText, guidText + vendor + productID, entry);
 
-            if (SDL_IsGameController(index) && !disableGameController)
+            if (isGameController && !entry.disableGameController)
             {
                 // Make sure to decrement reference count
                 SDL_JoystickClose(joystick);
@@ -699,18 +631,17 @@ void InputDaemon::addInputDevice(int index, QMap<QString,int>& uniques, int& cou
                         m_joysticks->insert(tempJoystickID_local_2, damncontroller);
                         trackcontrollers.insert(tempJoystickID_local_2, damncontroller);
 
-                        m_settings->endGroup();
-                        m_settings->getLock()->unlock();
+                        Logger::LogInfo(QString("New game controller found - #%1 [%2]")
+                                        .arg(index+1)
+                                        .arg(QTime::currentTime().toString("hh:mm:ss.zzz")));
 
                         emit deviceAdded(damncontroller);
                     }
-
-                    duplicatedGamepad = false;
-                }
-                else
-                {
-                    m_settings->endGroup();
-                    m_settings->getLock()->unlock();
+                    else
+                    {
+                        // Make sure to decrement reference count
+                        SDL_GameControllerClose(controller);
+                    }
                 }
             }
             else
@@ -719,8 +650,9 @@ void InputDaemon::addInputDevice(int index, QMap<QString,int>& uniques, int& cou
                 m_joysticks->insert(tempJoystickID_local, curJoystick);
                 getTrackjoysticksLocal().insert(tempJoystickID_local, curJoystick);
 
-                m_settings->endGroup();
-                m_settings->getLock()->unlock();
+                Logger::LogInfo(QString("New joystick found - #%1 [%2]")
+                                .arg(index+1)
+                                .arg(QTime::currentTime().toString("hh:mm:ss.zzz")));
 
                 emit deviceAdded(curJoystick);
             }
@@ -800,6 +732,7 @@ void InputDaemon::firstInputPass(QQueue<SDL_Event> *sdlEventQueue)
 
                     if (button != nullptr)
                     {
+                        joy->countInputEvent();
                         InputDeviceBitArrayStatus *pending = createOrGrabBitStatusEntry(&pendingEventValues, joy);
                         pending->changeButtonStatus(event.jbutton.button,
                                                   event.type == SDL_JOYBUTTONDOWN ? true : false);
@@ -824,6 +757,7 @@ void InputDaemon::firstInputPass(QQueue<SDL_Event> *sdlEventQueue)
 
                     if (axis != nullptr)
                     {
+                        joy->countAxisEvent(event.jaxis.axis, inputPass);
                         InputDeviceBitArrayStatus *temp = createOrGrabBitStatusEntry(&releaseEventsGenerated, joy, false);
                         temp->changeAxesStatus(event.jaxis.axis, event.jaxis.axis == 0);
 
@@ -850,6 +784,7 @@ void InputDaemon::firstInputPass(QQueue<SDL_Event> *sdlEventQueue)
 
                     if (dpad != nullptr)
                     {
+                        joy->countInputEvent();
                         InputDeviceBitArrayStatus *pending = createOrGrabBitStatusEntry(&pendingEventValues, joy);
                         pending->changeHatStatus(event.jhat.hat, (event.jhat.value != 0) ? true : false);
                         sdlEventQueue->append(event);
@@ -874,6 +809,7 @@ void InputDaemon::firstInputPass(QQueue<SDL_Event> *sdlEventQueue)
 
                     if (axis != nullptr)
                     {
+                        joy->countAxisEvent(event.caxis.axis, inputPass);
                         InputDeviceBitArrayStatus *temp = createOrGrabBitStatusEntry(&releaseEventsGenerated, joy, false);
 
                         if ((event.caxis.axis != SDL_CONTROLLER_AXIS_TRIGGERLEFT) &&
@@ -906,6 +842,7 @@ void InputDaemon::firstInputPass(QQueue<SDL_Event> *sdlEventQueue)
 
                     if (button != nullptr)
                     {
+                        joy->countInputEvent();
                         InputDeviceBitArrayStatus *pending = createOrGrabBitStatusEntry(&pendingEventValues, joy);
                         pending->changeButtonStatus(event.cbutton.button,
                                                   event.type == SDL_CONTROLLERBUTTONDOWN ? true : false);
@@ -1100,10 +1037,6 @@ void InputDaemon::secondInputPass(QQueue<SDL_Event> *sdlEventQueue)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
-    QMap<QString,int> uniques = QMap<QString,int>();
-    int counterUniques = 1;
-    bool duplicatedGamepad = false;
-
     QHash<SDL_JoystickID, InputDevice*> activeDevices;
 
     while (!sdlEventQueue->isEmpty())
@@ -1257,7 +1190,7 @@ void InputDaemon::secondInputPass(QQueue<SDL_Event> *sdlEventQueue)
             case SDL_JOYDEVICEADDED:
             case SDL_CONTROLLERDEVICEADDED:
             {
-                addInputDevice(event.jdevice.which, uniques, counterUniques, duplicatedGamepad);
+                addInputDevice(event.jdevice.which);
                 break;
             }
 
@@ -1348,26 +1281,36 @@ void InputDaemon::updatePollResetRate(int tempPollRate)
     if (wasActive) pollResetTimer.start();
 }
 
-void InputDaemon::convertMappingsToUnique(QSettings* sett, QString guidString, QString uniqueIdString)
+/**
+ * @brief Pick the duplicate number for a new game controller. Pads of the
+ *     same model are told apart by adding this number to the product ID.
+ *     The first pad gets 0 and further pads get 2, 3 and so on. Numbers of
+ *     pads that are still connected are never reused, so plugging in
+ *     another pad does not change the unique ID of the others.
+ * @param GUID of the new controller
+ * @return Lowest free duplicate number
+ */
+int InputDaemon::duplicateCounterFor(QString guidText)
 {
-    if (sett->contains(QString("%1Disable").arg(guidString)))
-    {
-        sett->setValue(QString("%1Disable").arg(uniqueIdString), sett->value(QString("%1Disable").arg(guidString)));
-        sett->remove(QString("%1Disable").arg(guidString));
-    }
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
 
-    if (sett->contains(guidString))
+    QSet<int> usedCounters;
+    QHashIterator<SDL_JoystickID, GameController*> iter(trackcontrollers);
+
+    while (iter.hasNext())
     {
-        QStringList gg = sett->value(guidString).toString().split(",");
-        qDebug() << "Convert guidString to uniqueString 1): " << gg << endl;
-        gg.removeFirst();
-        qDebug() << "Convert guidString to uniqueString 2): " << gg << endl;
-        gg.prepend(uniqueIdString);
-        qDebug() << "Convert guidString to uniqueString 3): " << gg << endl;
-        qDebug() << "Joined uniqueMapping: " << gg.join(",") << endl;
-        sett->setValue(uniqueIdString, gg.join(","));
-        sett->remove(guidString);
+        GameController *controller = iter.next().value();
+
+        if (controller->getGUIDString() == guidText)
+            usedCounters.insert(controller->getCounterUniques());
     }
+
+    if (!usedCounters.contains(0)) return 0;
+
+    int counter = 2;
+    while (usedCounters.contains(counter)) counter++;
+
+    return counter;
 }
 
 QHash<SDL_JoystickID, Joystick*>& InputDaemon::getTrackjoysticksLocal() {
@@ -59,7 +59,7 @@ protected:
     Joystick* openJoystickDevice(int index);
 
     void clearBitArrayStatusInstances();
-    void convertMappingsToUnique(QSettings* sett, QString guidString, QString uniqueIdString);
+    int duplicateCounterFor(QString guidText);
 
 signals:
     void joystickRefreshed (InputDevice *joystick);
@@ -82,7 +82,7 @@ public slots:
     void startWorker();
     void refreshMapping(QString mapping, InputDevice *device);
     void removeDevice(InputDevice *device);
-    void addInputDevice(int index, QMap<QString,int>& uniques, int &counterUniques, bool &duplicatedGamepad);
+    void addInputDevice(int index);
     void refreshIndexes();
 
 private slots:
@@ -104,6 +104,9 @@ private:
 
     bool stopped;
     bool m_graphical;
+    // Number of the current input pass. Used to spot axis events
+    // superseded within one pass.
+    quint32 inputPass;
 
     SDLEventReader *eventWorker;
     QThread *sdlWorkerThread;
@@ -22,6 +22,7 @@
 #include "messagehandler.h"
 #include "common.h"
 #include "antimicrosettings.h"
+#include "deviceregistry.h"
 #include "joydpad.h"
 #include "joycontrolstick.h"
 #include "joybuttontypes/joydpadbutton.h"
@@ -1438,6 +1439,37 @@ int InputDevice::getButtonDownCount()
     return buttonDownCount;
 }
 
+void InputDevice::countInputEvent()
+{
+    inputEventCount.fetchAndAddRelaxed(1);
+}
+
+/**
+ * @brief Count an axis event. Additional events for the same axis within one
+ *     input pass are counted as coalesced since only the last value matters.
+ * @param Index of the axis
+ * @param Number of the current input pass. Never zero.
+ */
+void InputDevice::countAxisEvent(int axisIndex, quint32 inputPass)
+{
+    inputEventCount.fetchAndAddRelaxed(1);
+
+    if (axisIndex >= axisEventPass.size()) axisEventPass.resize(axisIndex + 1);
+
+    if (axisEventPass.at(axisIndex) == inputPass) coalescedEventCount.fetchAndAddRelaxed(1);
+    else axisEventPass[axisIndex] = inputPass;
+}
+
+int InputDevice::getInputEventCount()
+{
+    return inputEventCount.loadAcquire();
+}
+
+int InputDevice::getCoalescedEventCount()
+{
+    return coalescedEventCount.loadAcquire();
+}
+
 QString InputDevice::getSDLPlatform()
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
@@ -1533,18 +1565,13 @@ bool InputDevice::isKnownController()
     }
     else
     {
-        m_settings->beginGroup("Mappings");
-
-//        if (m_settings->contains(getGUIDString())) result = true;
-//        else if (m_settings->contains(QString("%1%2").arg(getGUIDString()).arg("Disabled"))) result = true;
-
-        convertToUniqueMappSett(m_settings, getGUIDString(), getUniqueIDString());
-        convertToUniqueMappSett(m_settings, (QString("%1%2").arg(getGUIDString()).arg("Disabled")), (QString("%1%2").arg(getUniqueIDString()).arg("Disabled")));
+        // Other settings of the device, like its last profile, create an
+        // entry as well. Only a mapping or disabling game controller mode
+        // makes the device known.
+        DeviceRegistry::deviceRegistryEntry entry;
 
-        if (m_settings->contains(getUniqueIDString())) result = true;
-        else if (m_settings->contains(QString("%1%2").arg(getUniqueIDString()).arg("Disabled"))) result = true;
-
-        m_settings->endGroup();
+        if (DeviceRegistry::getInstance()->lookup(getGUIDString(), getUniqueIDString(), entry))
+            result = !entry.mapping.isEmpty() || entry.disableGameController;
     }
 
     return result;
@@ -1567,15 +1594,19 @@ void InputDevice::activatePossibleControlStickEvents()
 
     SetJoystick *currentSet = getActiveSetJoystick();
 
-    for (int i = 0; i < currentSet->getNumberSticks(); i++)
+    // Take only the elements that queued an event. Elements queued while
+    // this pass runs are handled by the next one.
+    pendingSticks.swap(currentSet->getPendingElements().sticks);
+
+    for (int i = 0; i < pendingSticks.size(); i++)
     {
-        JoyControlStick *tempStick = currentSet->getJoyStick(i);
+        JoyControlStick *tempStick = pendingSticks.at(i);
 
-        if ((tempStick != nullptr) && tempStick->hasPendingEvent())
-        {
+        if (tempStick->hasPendingEvent())
             tempStick->activatePendingEvent();
-        }
     }
+
+    pendingSticks.resize(0);
 }
 
 void InputDevice::activatePossibleAxisEvents()
@@ -1584,15 +1615,37 @@ void InputDevice::activatePossibleAxisEvents()
 
     SetJoystick *currentSet = getActiveSetJoystick();
 
-    for (int i = 0; i < currentSet->getNumberAxes(); i++)
+    axisKernel.clear();
+    axisKernelSlots.resize(0);
+    pendingAxes.swap(currentSet->getPendingElements().axes);
+
+    for (int i = 0; i < pendingAxes.size(); i++)
     {
-        JoyAxis *tempAxis = currentSet->getJoyAxis(i);
+        JoyAxis *tempAxis = pendingAxes.at(i);
 
-        if ((tempAxis != nullptr) && tempAxis->hasPendingEvent())
+        if (tempAxis->hasPendingEvent())
         {
-            tempAxis->activatePendingEvent();
+            axisKernel.append(static_cast<qint16>(tempAxis->getPendingValue()),
+                              tempAxis->getThrottle(), tempAxis->getDeadZone(),
+                              tempAxis->getMaxZoneValue(), tempAxis->getAxisMinCal(),
+                              tempAxis->getAxisMaxCal());
+            axisKernelSlots.append(tempAxis);
         }
     }
+
+    pendingAxes.resize(0);
+
+    if (axisKernelSlots.isEmpty())
+        return;
+
+    axisKernel.process();
+
+    for (int slot = 0; slot < axisKernelSlots.size(); slot++)
+    {
+        axisKernelSlots.at(slot)->activatePendingEvent(axisKernel.getThrottledValue(slot),
+                                                       axisKernel.isInDeadZone(slot),
+                                                       axisKernel.getDistance(slot));
+    }
 }
 
 void InputDevice::activatePossibleDPadEvents()
@@ -1601,13 +1654,17 @@ void InputDevice::activatePossibleDPadEvents()
 
     SetJoystick *currentSet = getActiveSetJoystick();
 
-    for (int i = 0; i < currentSet->getNumberHats(); i++)
+    pendingDPads.swap(currentSet->getPendingElements().dpads);
+
+    for (int i = 0; i < pendingDPads.size(); i++)
     {
-        JoyDPad *tempDPad = currentSet->getJoyDPad(i);
+        JoyDPad *tempDPad = pendingDPads.at(i);
 
-        if ((tempDPad != nullptr) && tempDPad->hasPendingEvent())
+        if (tempDPad->hasPendingEvent())
             tempDPad->activatePendingEvent();
     }
+
+    pendingDPads.resize(0);
 }
 
 void InputDevice::activatePossibleVDPadEvents()
@@ -1616,13 +1673,17 @@ void InputDevice::activatePossibleVDPadEvents()
 
     SetJoystick *currentSet = getActiveSetJoystick();
 
-    for (int i = 0; i < currentSet->getNumberVDPads(); i++)
+    pendingVDPads.swap(currentSet->getPendingElements().vdpads);
+
+    for (int i = 0; i < pendingVDPads.size(); i++)
     {
-        VDPad *tempVDPad = currentSet->getVDPad(i);
+        VDPad *tempVDPad = pendingVDPads.at(i);
 
-        if ((tempVDPad != nullptr) && tempVDPad->hasPendingEvent())
+        if (tempVDPad->hasPendingEvent())
             tempVDPad->activatePendingEvent();
     }
+
+    pendingVDPads.resize(0);
 }
 
 void InputDevice::activatePossibleButtonEvents()
@@ -1631,13 +1692,17 @@ void InputDevice::activatePossibleButtonEvents()
 
     SetJoystick *currentSet = getActiveSetJoystick();
 
-    for (int i = 0; i < currentSet->getNumberButtons(); i++)
+    pendingButtons.swap(currentSet->getPendingElements().buttons);
+
+    for (int i = 0; i < pendingButtons.size(); i++)
     {
-        JoyButton *tempButton = currentSet->getJoyButton(i);
+        JoyButton *tempButton = pendingButtons.at(i);
 
-        if ((tempButton != nullptr) && tempButton->hasPendingEvent())
+        if (tempButton->hasPendingEvent())
             tempButton->activatePendingEvent();
     }
+
+    pendingButtons.resize(0);
 }
 
 bool InputDevice::elementsHaveNames()
@@ -21,9 +21,13 @@
 #define INPUTDEVICE_H
 
 #include "setjoystick.h"
+#include "joyaxiskernel.h"
 
 #include <SDL2/SDL_joystick.h>
 
+#include <QAtomicInt>
+#include <QVector>
+
 
 class AntiMicroSettings;
 class SetJoystick;
@@ -242,6 +246,24 @@ private:
     QList<bool> buttonstates;
     QList<int> axesstates;
     QList<int> dpadstates;
+
+    // Read by the stats query on the main thread while the
+    // input thread increments them.
+    QAtomicInt inputEventCount;
+    QAtomicInt coalescedEventCount;
+    QVector<quint32> axisEventPass;
+
+    // Only used on the input thread by activatePossibleAxisEvents.
+    JoyAxisKernel axisKernel;
+    QVector<JoyAxis*> axisKernelSlots;
+
+    // Pending elements taken from the active set by the activation pass.
+    // Swapped with the lists of the set so both keep their capacity.
+    QVector<JoyControlStick*> pendingSticks;
+    QVector<JoyAxis*> pendingAxes;
+    QVector<JoyDPad*> pendingDPads;
+    QVector<VDPad*> pendingVDPads;
+    QVector<JoyButton*> pendingButtons;
 };
 
 Q_DECLARE_METATYPE(InputDevice*)
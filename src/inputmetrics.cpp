@@ -0,0 +1,122 @@
+/* antimicroX Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ * Copyright (C) 2020 Jagoda Górska <juliagoda.pl@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "inputmetrics.h"
+
+#include <QtGlobal>
+
+
+QAtomicInt InputMetrics::timerEvents;
+QAtomicInt InputMetrics::mouseTicks;
+QAtomicInteger<qint64> InputMetrics::mouseJitterTotal;
+QAtomicInt InputMetrics::mouseJitterSamples;
+QAtomicInt InputMetrics::mouseJitterMax;
+QElapsedTimer InputMetrics::mouseTickClock;
+qint64 InputMetrics::lastMouseTick = -1;
+QElapsedTimer InputMetrics::rateClock;
+QHash<QString, InputMetrics::rateSample> InputMetrics::rateSamples;
+
+
+void InputMetrics::countTimerEvent()
+{
+    timerEvents.fetchAndAddRelaxed(1);
+}
+
+/**
+ * @brief Count a tick of the static mouse timer and record how far the time
+ *     since the previous tick strays from the timer interval. Gaps longer than
+ *     two intervals come from the timer being restarted or switching to the
+ *     idle rate and are not treated as jitter.
+ * @param Current interval of the mouse timer in milliseconds
+ */
+void InputMetrics::countMouseTick(int interval)
+{
+    mouseTicks.fetchAndAddRelaxed(1);
+
+    if (!mouseTickClock.isValid()) mouseTickClock.start();
+
+    qint64 now = mouseTickClock.nsecsElapsed();
+    qint64 previous = lastMouseTick;
+    lastMouseTick = now;
+
+    if ((previous < 0) || (interval <= 0)) return;
+
+    qint64 expected = static_cast<qint64>(interval) * 1000000;
+    qint64 elapsed = now - previous;
+
+    if (elapsed >= (expected * 2)) return;
+
+    int jitter = static_cast<int>(qAbs(elapsed - expected) / 1000);
+    mouseJitterTotal.fetchAndAddRelaxed(jitter);
+    mouseJitterSamples.fetchAndAddRelaxed(1);
+
+    int currentMax = mouseJitterMax.loadAcquire();
+
+    while ((jitter > currentMax) && !mouseJitterMax.testAndSetOrdered(currentMax, jitter))
+    {
+        currentMax = mouseJitterMax.loadAcquire();
+    }
+}
+
+int InputMetrics::getTimerEventCount()
+{
+    return timerEvents.loadAcquire();
+}
+
+int InputMetrics::getMouseTickCount()
+{
+    return mouseTicks.loadAcquire();
+}
+
+void InputMetrics::takeMouseJitter(int &average, int &maximum)
+{
+    qint64 total = mouseJitterTotal.fetchAndStoreOrdered(0);
+    int samples = mouseJitterSamples.fetchAndStoreOrdered(0);
+
+    average = (samples > 0) ? static_cast<int>(total / samples) : 0;
+    maximum = mouseJitterMax.fetchAndStoreOrdered(0);
+}
+
+double InputMetrics::ratePerSecond(QString const& key, int counter)
+{
+    if (!rateClock.isValid()) rateClock.start();
+
+    qint64 now = rateClock.elapsed();
+    double rate = 0.0;
+
+    QHash<QString, rateSample>::iterator iter = rateSamples.find(key);
+
+    if (iter != rateSamples.end())
+    {
+        qint64 elapsed = now - iter->timestamp;
+
+        // Unsigned difference stays correct when a counter wraps.
+        if (elapsed > 0) rate = (static_cast<quint32>(counter) - iter->counter) * 1000.0 / elapsed;
+
+        iter->counter = static_cast<quint32>(counter);
+        iter->timestamp = now;
+    }
+    else
+    {
+        rateSample sample = {static_cast<quint32>(counter), now};
+        rateSamples.insert(key, sample);
+    }
+
+    return rate;
+}
@@ -0,0 +1,80 @@
+/* antimicroX Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ * Copyright (C) 2020 Jagoda Górska <juliagoda.pl@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef INPUTMETRICS_H
+#define INPUTMETRICS_H
+
+#include <QAtomicInt>
+#include <QAtomicInteger>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QString>
+
+
+/**
+ * @brief Process wide counters served by the stats query of the local
+ *     server. Counters are only ever incremented on the hot paths and read
+ *     from the main thread when a query arrives.
+ */
+class InputMetrics
+{
+public:
+    static void countTimerEvent();
+    static void countMouseTick(int interval);
+
+    static int getTimerEventCount();
+    static int getMouseTickCount();
+
+    /**
+     * @brief Mouse timer jitter gathered since the previous call.
+     * @param Average deviation from the timer interval in microseconds
+     * @param Largest deviation from the timer interval in microseconds
+     */
+    static void takeMouseJitter(int &average, int &maximum);
+
+    /**
+     * @brief Rate of a counter since the previous call with the same key.
+     *     Only meant to be called from the main thread.
+     * @param Name of the counter
+     * @param Current counter value
+     * @return Increments per second. Zero on the first call.
+     */
+    static double ratePerSecond(QString const& key, int counter);
+
+private:
+    struct rateSample {
+        quint32 counter;
+        qint64 timestamp;
+    };
+
+    static QAtomicInt timerEvents;
+    static QAtomicInt mouseTicks;
+    static QAtomicInteger<qint64> mouseJitterTotal;
+    static QAtomicInt mouseJitterSamples;
+    static QAtomicInt mouseJitterMax;
+
+    // Only touched by the mouse timer thread.
+    static QElapsedTimer mouseTickClock;
+    static qint64 lastMouseTick;
+
+    static QElapsedTimer rateClock;
+    static QHash<QString, rateSample> rateSamples;
+};
+
+#endif // INPUTMETRICS_H
@@ -48,6 +48,10 @@ JoyAxis::JoyAxis(int index, int originset, SetJoystick *parentSet,
     axis_min_cal = -1;
     axis_center_cal = -1;
     currentRawValue = 0;
+    kernelDistance = 0.0;
+    kernelDistanceValue = 0;
+    kernelDistanceDeadZone = -1;
+    kernelDistanceMaxZone = -1;
     m_originset = originset;
     m_parentSet = parentSet;
     naxisbutton = new JoyAxisButton(this, 0, originset, parentSet, this);
@@ -68,6 +72,8 @@ void JoyAxis::queuePendingEvent(int value, bool ignoresets, bool updateLastValue
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
+    bool wasPending = pendingEvent;
+
     pendingEvent = false;
     pendingValue = 0;
     pendingIgnoreSets = false;
@@ -78,6 +84,9 @@ void JoyAxis::queuePendingEvent(int value, bool ignoresets, bool updateLastValue
     }
     else
     {
+        if (!wasPending && (m_parentSet != nullptr))
+            m_parentSet->addPendingElement(this);
+
         pendingEvent = true;
         pendingValue = value;
         pendingIgnoreSets = ignoresets;
@@ -182,27 +191,77 @@ void JoyAxis::joyEvent(int value, bool ignoresets, bool updateLastValues)
             currentThrottledValue = calculateThrottledValue(value);
         }
 
-        if (safezone && !isActive)
-        {
-            isActive = eventActive = true;
-            emit active(value);
-            createDeskEvent(ignoresets);
-        }
-        else if (!safezone && isActive)
-        {
-            isActive = eventActive = false;
-            emit released(value);
-            createDeskEvent(ignoresets);
-        }
-        else if (isActive)
-        {
-            createDeskEvent(ignoresets);
-        }
+        updateActiveState(value, safezone, ignoresets);
     }
 
     emit moved(currentRawValue);
 }
 
+/**
+ * @brief Consume the result calculated for the pending value by
+ *     JoyAxisKernel. Axes that are part of a stick or still need
+ *     calibration go through the scalar path.
+ * @param Throttled value of the pending raw value
+ * @param Whether the pending raw value is inside the dead zone
+ * @param Distance of the throttled value from the dead zone
+ */
+void JoyAxis::activatePendingEvent(int throttledValue, bool deadZoneState, double distance)
+{
+    if (!pendingEvent)
+        return;
+
+    InputDevice *device = m_parentSet->getInputDevice();
+
+    if ((m_stick != nullptr) || (!device->isGameController() && !device->hasCalibrationThrottle(m_index)))
+    {
+        activatePendingEvent();
+        return;
+    }
+
+    lastKnownThottledValue = currentThrottledValue;
+    lastKnownRawValue = currentRawValue;
+
+    currentRawValue = qBound(getAxisMinCal(), pendingValue, getAxisMaxCal());
+    currentThrottledValue = throttledValue;
+
+    kernelDistance = distance;
+    kernelDistanceValue = throttledValue;
+    kernelDistanceDeadZone = deadZone;
+    kernelDistanceMaxZone = maxZoneValue;
+
+    updateActiveState(pendingValue, !deadZoneState, pendingIgnoreSets);
+    emit moved(currentRawValue);
+
+    pendingEvent = false;
+    pendingValue = 0;
+    pendingIgnoreSets = false;
+}
+
+int JoyAxis::getPendingValue()
+{
+    return pendingValue;
+}
+
+void JoyAxis::updateActiveState(int value, bool safezone, bool ignoresets)
+{
+    if (safezone && !isActive)
+    {
+        isActive = eventActive = true;
+        emit active(value);
+        createDeskEvent(ignoresets);
+    }
+    else if (!safezone && isActive)
+    {
+        isActive = eventActive = false;
+        emit released(value);
+        createDeskEvent(ignoresets);
+    }
+    else if (isActive)
+    {
+        createDeskEvent(ignoresets);
+    }
+}
+
 bool JoyAxis::inDeadZone(int value)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
@@ -505,6 +564,11 @@ void JoyAxis::resetPrivateVars()
     eventActive = false;
     maxZoneValue = GlobalVariables::JoyAxis::AXISMAXZONE;
     throttle = this->DEFAULTTHROTTLE;
+    outputCurve.clear();
+
+    outputCurveTableMutex.lock();
+    outputCurveTable.clear();
+    outputCurveTableMutex.unlock();
 
     paxisbutton->reset();
     naxisbutton->reset();
@@ -584,6 +648,12 @@ double JoyAxis::getDistanceFromDeadZone()
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
+    if ((kernelDistanceValue == currentThrottledValue) &&
+        (kernelDistanceDeadZone == deadZone) && (kernelDistanceMaxZone == maxZoneValue))
+    {
+        return applyOutputCurve(kernelDistance);
+    }
+
     return getDistanceFromDeadZone(currentThrottledValue);
 }
 
@@ -602,7 +672,56 @@ double JoyAxis::getDistanceFromDeadZone(int value)
         distance = static_cast<double>(value + deadZone)/( (-maxZoneValue) + deadZone);
     }
 
-    return qBound(0.0, distance, 1.0);
+    distance = qBound(0.0, distance, 1.0);
+
+    return applyOutputCurve(distance);
+}
+
+/**
+ * @brief Apply the output curve to a distance from the dead zone. Safe to
+ *     call from the input thread while the curve is being replaced.
+ */
+double JoyAxis::applyOutputCurve(double distance)
+{
+    outputCurveTableMutex.lock();
+    QSharedPointer<const ResponseCurveTable> table = outputCurveTable;
+    outputCurveTableMutex.unlock();
+
+    return table.isNull() ? distance : table->lookup(distance);
+}
+
+/**
+ * @brief Set the curve applied to the distance from the dead zone.
+ * @param Curve to use. An empty curve restores the linear response.
+ */
+void JoyAxis::setOutputCurve(ResponseCurve const& curve)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    if (curve != outputCurve)
+    {
+        QSharedPointer<ResponseCurveTable> tempTable;
+
+        if (!curve.isEmpty())
+        {
+            tempTable = QSharedPointer<ResponseCurveTable>(new ResponseCurveTable());
+            curve.fillTable(*tempTable);
+        }
+
+        outputCurveTableMutex.lock();
+        outputCurveTable = tempTable;
+        outputCurveTableMutex.unlock();
+
+        outputCurve = curve;
+        emit propertyUpdated();
+    }
+}
+
+ResponseCurve JoyAxis::getOutputCurve()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    return outputCurve;
 }
 
 /**
@@ -709,6 +828,7 @@ bool JoyAxis::isDefault()
     bool value = true;
     value = value && (deadZone == getDefaultDeadZone());
     value = value && (maxZoneValue == getDefaultMaxZone());
+    value = value && (outputCurve.isEmpty());
     value = value && (paxisbutton->isDefault());
     value = value && (naxisbutton->isDefault());
 
@@ -1076,6 +1196,16 @@ void JoyAxis::copyAssignments(JoyAxis *destAxis)
     destAxis->reset();
     destAxis->deadZone = deadZone;
     destAxis->maxZoneValue = maxZoneValue;
+    destAxis->outputCurve = outputCurve;
+
+    // Published tables are never changed so both axes can share one
+    outputCurveTableMutex.lock();
+    QSharedPointer<const ResponseCurveTable> tempTable = outputCurveTable;
+    outputCurveTableMutex.unlock();
+
+    destAxis->outputCurveTableMutex.lock();
+    destAxis->outputCurveTable = tempTable;
+    destAxis->outputCurveTableMutex.unlock();
     destAxis->axisName = axisName;
     paxisbutton->copyAssignments(destAxis->paxisbutton);
     naxisbutton->copyAssignments(destAxis->naxisbutton);
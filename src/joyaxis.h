@@ -22,8 +22,12 @@
 
 #include <QObject>
 #include <QList>
+#include <QMutex>
+#include <QSharedPointer>
 
 #include "joybuttontypes/joyaxisbutton.h"
+#include "responsecurve.h"
+#include "responsecurvetable.h"
 
 class JoyControlStick;
 class SetJoystick;
@@ -52,6 +56,8 @@ public:
     void joyEvent(int value, bool ignoresets=false, bool updateLastValues=true); // JoyAxisEvent class
     void queuePendingEvent(int value, bool ignoresets=false, bool updateLastValues=true); // JoyAxisEvent class
     void activatePendingEvent(); // JoyAxisEvent class
+    void activatePendingEvent(int throttledValue, bool deadZoneState, double distance); // JoyAxisEvent class
+    int getPendingValue(); // JoyAxisEvent class
     bool hasPendingEvent(); // JoyAxisEvent class
     void clearPendingEvent(); // JoyAxisEvent class
     bool inDeadZone(int value);
@@ -84,6 +90,9 @@ public:
     double getDistanceFromDeadZone(int value);
     double getRawDistance(int value);
 
+    void setOutputCurve(ResponseCurve const& curve);
+    ResponseCurve getOutputCurve();
+
     void setControlStick(JoyControlStick *stick);
     void removeControlStick(bool performRelease = true);
     bool isPartControlStick();
@@ -160,6 +169,8 @@ protected:
 
     void performCalibration(int value);
     void stickPassEvent(int value, bool ignoresets=false, bool updateLastValues=true); // JoyAxisEvent class
+    void updateActiveState(int value, bool safezone, bool ignoresets); // JoyAxisEvent class
+    double applyOutputCurve(double distance);
 
     JoyAxisButton *paxisbutton;
     JoyAxisButton *naxisbutton;
@@ -181,6 +192,22 @@ protected:
     int lastKnownRawValue;
     int pendingValue;
 
+    // Distance calculated by JoyAxisKernel and the state it is valid for
+    double kernelDistance;
+    int kernelDistanceValue;
+    int kernelDistanceDeadZone;
+    int kernelDistanceMaxZone;
+
+    // Applied to the distance from the dead zone before it reaches the
+    // axis buttons. Empty curve means a linear response.
+    ResponseCurve outputCurve;
+
+    // Table of outputCurve read by the input thread. Replaced as a whole
+    // under outputCurveTableMutex and never changed once published. Null
+    // for a linear response.
+    QSharedPointer<const ResponseCurveTable> outputCurveTable;
+    QMutex outputCurveTableMutex;
+
     bool isActive;
     bool pendingEvent;
     bool pendingIgnoreSets;
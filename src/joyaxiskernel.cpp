@@ -0,0 +1,140 @@
+/* antimicroX Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ * Copyright (C) 2020 Jagoda Górska <juliagoda.pl@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "joyaxiskernel.h"
+
+#include "joyaxis.h"
+
+
+// Same results as JoyAxis::calculateThrottledValue written as selects
+// so the loop in process() can be vectorised.
+static inline int throttleValue(int value, int throttle, int minCal, int maxCal)
+{
+    const int magnitude = (value < 0) ? -value : value;
+    int result = value;
+
+    result = (throttle == JoyAxis::NegativeHalfThrottle) ? -magnitude : result;
+    result = (throttle == JoyAxis::NegativeThrottle) ? (value + minCal) / 2 : result;
+    result = (throttle == JoyAxis::PositiveThrottle) ? (value + maxCal) / 2 : result;
+    result = (throttle == JoyAxis::PositiveHalfThrottle) ? magnitude : result;
+
+    return result;
+}
+
+JoyAxisKernel::JoyAxisKernel()
+{
+    pending = 0;
+}
+
+void JoyAxisKernel::clear()
+{
+    pending = 0;
+}
+
+int JoyAxisKernel::append(qint16 rawValue, int throttle, int deadZone, int maxZone,
+                          int minCal, int maxCal)
+{
+    if (pending >= rawValues.size())
+        reserveSlots(qMax(8, pending * 2));
+
+    const int slot = pending++;
+
+    rawValues[slot] = rawValue;
+    throttles[slot] = throttle;
+    deadZones[slot] = deadZone;
+    maxZones[slot] = maxZone;
+    minCals[slot] = minCal;
+    maxCals[slot] = maxCal;
+
+    return slot;
+}
+
+void JoyAxisKernel::process()
+{
+    const qint16 *raw = rawValues.constData();
+    const int *throttle = throttles.constData();
+    const int *deadZone = deadZones.constData();
+    const int *maxZone = maxZones.constData();
+    const int *minCal = minCals.constData();
+    const int *maxCal = maxCals.constData();
+
+    int *throttled = throttledValues.data();
+    quint8 *deadFlags = deadZoneFlags.data();
+    double *distance = distances.data();
+
+    for (int i = 0; i < pending; i++)
+    {
+        const int value = raw[i];
+
+        // JoyAxis::setCurrentRawValue keeps the raw value inside the
+        // calibrated range before the dead zone test while the throttled
+        // value is calculated from the unclamped value.
+        int clamped = (value < minCal[i]) ? minCal[i] : value;
+        clamped = (clamped > maxCal[i]) ? maxCal[i] : clamped;
+
+        const int current = throttleValue(value, throttle[i], minCal[i], maxCal[i]);
+        const int deadTest = throttleValue(clamped, throttle[i], minCal[i], maxCal[i]);
+        const int deadMagnitude = (deadTest < 0) ? -deadTest : deadTest;
+
+        throttled[i] = current;
+        deadFlags[i] = (deadMagnitude <= deadZone[i]) ? 1 : 0;
+
+        // Both directions of JoyAxis::getDistanceFromDeadZone reduce to
+        // the distance of the magnitude past the dead zone.
+        const int magnitude = (current < 0) ? -current : current;
+        const int span = maxZone[i] - deadZone[i];
+        double result = (span > 0) ? static_cast<double>(magnitude - deadZone[i]) / span :
+                                     ((magnitude >= deadZone[i]) ? 1.0 : 0.0);
+        result = (result < 0.0) ? 0.0 : result;
+        distance[i] = (result > 1.0) ? 1.0 : result;
+    }
+}
+
+int JoyAxisKernel::count() const
+{
+    return pending;
+}
+
+int JoyAxisKernel::getThrottledValue(int slot) const
+{
+    return throttledValues.at(slot);
+}
+
+bool JoyAxisKernel::isInDeadZone(int slot) const
+{
+    return deadZoneFlags.at(slot) != 0;
+}
+
+double JoyAxisKernel::getDistance(int slot) const
+{
+    return distances.at(slot);
+}
+
+void JoyAxisKernel::reserveSlots(int size)
+{
+    rawValues.resize(size);
+    throttles.resize(size);
+    deadZones.resize(size);
+    maxZones.resize(size);
+    minCals.resize(size);
+    maxCals.resize(size);
+    throttledValues.resize(size);
+    deadZoneFlags.resize(size);
+    distances.resize(size);
+}
@@ -0,0 +1,73 @@
+/* antimicroX Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ * Copyright (C) 2020 Jagoda Górska <juliagoda.pl@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef JOYAXISKERNEL_H
+#define JOYAXISKERNEL_H
+
+#include <QVector>
+#include <QtGlobal>
+
+
+/**
+ * @brief Batch form of the per axis throttle, dead zone and distance
+ *     calculations done by JoyAxis. Pending raw values of a device are
+ *     gathered into flat arrays and processed in one branch free loop so
+ *     devices with many axes do not pay the scalar path for every axis.
+ *     Buffers keep their capacity between passes.
+ */
+class JoyAxisKernel
+{
+public:
+    JoyAxisKernel();
+
+    void clear();
+
+    /**
+     * @brief Queue a raw axis value together with the axis settings used
+     *     to process it.
+     * @return Slot holding the results after process() was called
+     */
+    int append(qint16 rawValue, int throttle, int deadZone, int maxZone,
+               int minCal, int maxCal);
+
+    void process();
+
+    int count() const;
+    int getThrottledValue(int slot) const;
+    bool isInDeadZone(int slot) const;
+    double getDistance(int slot) const;
+
+private:
+    void reserveSlots(int size);
+
+    int pending;
+
+    QVector<qint16> rawValues;
+    QVector<int> throttles;
+    QVector<int> deadZones;
+    QVector<int> maxZones;
+    QVector<int> minCals;
+    QVector<int> maxCals;
+
+    QVector<int> throttledValues;
+    QVector<quint8> deadZoneFlags;
+    QVector<double> distances;
+};
+
+#endif // JOYAXISKERNEL_H
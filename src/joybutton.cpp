@@ -24,6 +24,7 @@
 #include "vdpad.h"
 #include "event.h"
 #include "logger.h"
+#include "inputmetrics.h"
 
 #include "SDL2/SDL_events.h"
 #include "eventhandlerfactory.h"
@@ -49,12 +50,12 @@ JoyButtonSlot* JoyButton::lastActiveKey = nullptr;
 QList<JoyButtonSlot*> JoyButton::mouseSpeedModList;
 
 // Lists used for cursor mode calculations.
-QList<JoyButton::mouseCursorInfo> JoyButton::cursorXSpeeds;
-QList<JoyButton::mouseCursorInfo> JoyButton::cursorYSpeeds;
+JoyButton::mouseCursorList JoyButton::cursorXSpeeds;
+JoyButton::mouseCursorList JoyButton::cursorYSpeeds;
 
 // Lists used for spring mode calculations.
-QList<PadderCommon::springModeInfo> JoyButton::springXSpeeds;
-QList<PadderCommon::springModeInfo> JoyButton::springYSpeeds;
+JoyButton::springModeList JoyButton::springXSpeeds;
+JoyButton::springModeList JoyButton::springYSpeeds;
 
 // Temporary test object to test old mouse time behavior.
 QTime JoyButton::testOldMouseTime;
@@ -84,6 +85,9 @@ JoyButton::JoyButton(int index, int originset, SetJoystick *parentSet,
 
     m_vdpad = nullptr;
     slotiter = nullptr;
+    mouseCurveTableCurve = LinearCurve;
+    mouseCurveTableSensitivity = 0.0;
+    customMouseCurve = QSharedPointer<const ResponseCurve>(new ResponseCurve());
 
     threadPool = QThreadPool::globalInstance();
 
@@ -117,6 +121,13 @@ JoyButton::JoyButton(int index, int originset, SetJoystick *parentSet,
     connect(&slotSetChangeTimer, &QTimer::timeout, this, &JoyButton::slotSetChange);
     connect(&activeZoneTimer, &QTimer::timeout, this, &JoyButton::buildActiveZoneSummaryString);
 
+    for (QTimer *timer : {&pauseWaitTimer, &keyPressTimer, &holdTimer, &delayTimer, &createDeskTimer,
+                          &releaseDeskTimer, &turboTimer, &mouseWheelVerticalEventTimer,
+                          &mouseWheelHorizontalEventTimer, &setChangeTimer, &slotSetChangeTimer})
+    {
+        connect(timer, &QTimer::timeout, &InputMetrics::countTimerEvent);
+    }
+
     activeZoneTimer.setInterval(0);
     activeZoneTimer.setSingleShot(true);
 
@@ -146,10 +157,21 @@ void JoyButton::queuePendingEvent(bool pressed, bool ignoresets)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
+    bool wasPending = pendingEvent;
+
     updatePendingParams(false, false, false);
 
-    if (m_vdpad != nullptr) vdpadPassEvent(pressed, ignoresets);
-    else updatePendingParams(true, pressed, ignoresets);
+    if (m_vdpad != nullptr)
+    {
+        vdpadPassEvent(pressed, ignoresets);
+    }
+    else
+    {
+        if (!wasPending && (m_parentSet != nullptr))
+            m_parentSet->addPendingElement(this);
+
+        updatePendingParams(true, pressed, ignoresets);
+    }
 }
 
 void JoyButton::activatePendingEvent()
@@ -275,9 +297,11 @@ void JoyButton::joyEvent(bool pressed, bool ignoresets)
                 else if (!isButtonPressed && !activePress && turboTimer.isActive())
                 {
                     turboTimer.stop();
-                    Logger::LogDebug(tr("Finishing turbo for button #%1 - %2")
-                                    .arg(m_parentSet->getInputDevice()->getRealJoyNumber())
-                                    .arg(getPartialName()));
+
+                    if (Logger::isLogLevelEnabled(Logger::LOG_DEBUG))
+                        Logger::LogDebug(tr("Finishing turbo for button #%1 - %2")
+                                        .arg(m_parentSet->getInputDevice()->getRealJoyNumber())
+                                        .arg(getPartialName()));
 
                     if (isKeyPressed) turboEvent();
                     else lastDistance = getMouseDistanceFromDeadZone();
@@ -304,9 +328,10 @@ void JoyButton::joyEvent(bool pressed, bool ignoresets)
             }
             else if (!isButtonPressed && !activePress)
             {
-                Logger::LogDebug(tr("Processing release for button #%1 - %2")
-                                .arg(m_parentSet->getInputDevice()->getRealJoyNumber())
-                                .arg(getPartialName()));
+                if (Logger::isLogLevelEnabled(Logger::LOG_DEBUG))
+                    Logger::LogDebug(tr("Processing release for button #%1 - %2")
+                                    .arg(m_parentSet->getInputDevice()->getRealJoyNumber())
+                                    .arg(getPartialName()));
 
                 waitForReleaseDeskEvent();
             }
@@ -331,9 +356,10 @@ void JoyButton::updateParamsAfterDistEvent()
 {
     if (distanceEvent())
     {
-        Logger::LogDebug(tr("Distance change for button #%1 - %2")
-                        .arg(m_parentSet->getInputDevice()->getRealJoyNumber())
-                        .arg(getPartialName()));
+        if (Logger::isLogLevelEnabled(Logger::LOG_DEBUG))
+            Logger::LogDebug(tr("Distance change for button #%1 - %2")
+                            .arg(m_parentSet->getInputDevice()->getRealJoyNumber())
+                            .arg(getPartialName()));
 
         quitEvent = true;
         buttonHold.restart();
@@ -368,9 +394,10 @@ void JoyButton::startSequenceOfPressActive(bool isTurbo, QString debugText)
 
     currentAccelerationDistance = getAccelerationDistance();
 
-    Logger::LogDebug(debugText
-                    .arg(m_parentSet->getInputDevice()->getRealJoyNumber())
-                    .arg(getPartialName()));
+    if (Logger::isLogLevelEnabled(Logger::LOG_DEBUG))
+        Logger::LogDebug(debugText
+                        .arg(m_parentSet->getInputDevice()->getRealJoyNumber())
+                        .arg(getPartialName()));
 
 }
 
@@ -744,7 +771,7 @@ void JoyButton::activateMiniSlots(JoyButtonSlot* slot, JoyButtonSlot* mix)
         {
             sendKeybEvent(slot, true);
 
-            getActiveSlotsLocal().append(slot);
+            appendActiveSlot(slot);
             int oldvalue = GlobalVariables::JoyButton::JoyButton::activeKeys.value(tempcode, 0) + 1;
             GlobalVariables::JoyButton::JoyButton::activeKeys.insert(tempcode, oldvalue);
 
@@ -782,7 +809,7 @@ void JoyButton::addEachSlotToActives(JoyButtonSlot* slot, int& i, bool& delaySeq
 
                 sendevent(slot, true);
 
-                getActiveSlotsLocal().append(slot);
+                appendActiveSlot(slot);
                 int oldvalue = GlobalVariables::JoyButton::JoyButton::activeKeys.value(tempcode, 0) + 1;
                 GlobalVariables::JoyButton::JoyButton::activeKeys.insert(tempcode, oldvalue);
 
@@ -814,7 +841,7 @@ void JoyButton::addEachSlotToActives(JoyButtonSlot* slot, int& i, bool& delaySeq
                     slot->getMouseInterval()->restart();
                     wheelVerticalTime.restart();
                     currentWheelVerticalEvent = slot;
-                    getActiveSlotsLocal().append(slot);
+                    appendActiveSlot(slot);
                     wheelEventVertical();
                     currentWheelVerticalEvent = nullptr;
                 }
@@ -824,14 +851,14 @@ void JoyButton::addEachSlotToActives(JoyButtonSlot* slot, int& i, bool& delaySeq
                     slot->getMouseInterval()->restart();
                     wheelHorizontalTime.restart();
                     currentWheelHorizontalEvent = slot;
-                    getActiveSlotsLocal().append(slot);
+                    appendActiveSlot(slot);
                     wheelEventHorizontal();
                     currentWheelHorizontalEvent = nullptr;
                 }
                 else
                 {
                     sendevent(slot, true);
-                    getActiveSlotsLocal().append(slot);
+                    appendActiveSlot(slot);
                     int oldvalue = GlobalVariables::JoyButton::JoyButton::activeMouseButtons.value(tempcode, 0) + 1;
                     GlobalVariables::JoyButton::JoyButton::activeMouseButtons.insert(tempcode, oldvalue);
                 }
@@ -846,7 +873,7 @@ void JoyButton::addEachSlotToActives(JoyButtonSlot* slot, int& i, bool& delaySeq
 
                 slot->getMouseInterval()->restart();
 
-                getActiveSlotsLocal().append(slot);
+                appendActiveSlot(slot);
 
                    if (pendingMouseButtons.size() == 0)
                        mouseHelper.setFirstSpringStatus(true);
@@ -989,7 +1016,7 @@ void JoyButton::addEachSlotToActives(JoyButtonSlot* slot, int& i, bool& delaySeq
 
                 GlobalVariables::JoyButton::mouseSpeedModifier = tempcode * 0.01;
                 mouseSpeedModList.append(slot);
-                getActiveSlotsLocal().append(slot);
+                appendActiveSlot(slot);
 
                 break;
             }
@@ -1047,7 +1074,7 @@ void JoyButton::addEachSlotToActives(JoyButtonSlot* slot, int& i, bool& delaySeq
 
                 qDebug() << i << ": It's a JoySetChange with code: " << tempcode << " and name: " << slot->getSlotString();
 
-                getActiveSlotsLocal().append(slot);
+                appendActiveSlot(slot);
 
                 break;
             }
@@ -1106,10 +1133,12 @@ void JoyButton::mouseEvent()
     {
         updateMouseParams(true, true, 0.0);
 
-        QQueue<JoyButtonSlot*> tempQueue;
+        // Slots stay in mouseEventQueue while they are active so a tick
+        // does not rebuild the queue.
+        int queueIndex = 0;
 
         if (buttonslot == nullptr)
-            buttonslot = mouseEventQueue.dequeue();
+            buttonslot = mouseEventQueue.at(queueIndex);
 
         int timeElapsed = testOldMouseTime.elapsed();
 
@@ -1127,7 +1156,7 @@ void JoyButton::mouseEvent()
             int mousedirection = buttonslot->getSlotCode();
             JoyButton::JoyMouseMovementMode mousemode = getMouseMode();
 
-            bool isActive = getActiveSlots().contains(buttonslot);
+            bool isActive = buttonslot->isActive();
 
             if (isActive)
             {
@@ -1156,80 +1185,13 @@ void JoyButton::mouseEvent()
 
                     switch (currentCurve)
                     {
-                        case QuadraticCurve:
-                        {
-                            difference = difference * difference;
-                            break;
-                        }
-                        case CubicCurve:
-                        {
-                            difference = difference * difference * difference;
-                            break;
-                        }
-                        case QuadraticExtremeCurve:
-                        {
-                            double temp = difference;
-                            difference = difference * difference;
-                            difference = (temp >= 0.95) ? (difference * 1.5) : difference;
-                            break;
-                        }
-                        case PowerCurve:
-                        {
-                            double tempsensitive = qMin(qMax(sensitivity, 1.0e-3), 1.0e+3);
-                            double temp = qMin(qMax(pow(difference, 1.0 / tempsensitive), 0.0), 1.0);
-                            difference = temp;
-                            break;
-                        }
-                        case EnhancedPrecisionCurve:
-                        {
-                            // Perform different forms of acceleration depending on
-                            // the range of the element from its assigned dead zone.
-                            // Useful for more precise controls with an axis.
-                            double temp = difference;
-                            if (temp <= 0.4)
-                            {
-                                // Low slope value for really slow acceleration
-                                difference = (difference * 0.37);
-                            }
-                            else if (temp <= 0.75)
-                            {
-                                // Perform Linear accleration with an appropriate
-                                // offset.
-                                difference = (difference - 0.252);
-                            }
-                            else
-                            {
-                                // Perform mouse acceleration. Make up the difference
-                                // due to the previous two segments. Maxes out at 1.0.
-                                difference = (difference * 2.008) - 1.008;
-                            }
-
-                            break;
-                        }
                         case EasingQuadraticCurve:
                         case EasingCubicCurve:
                         {
-                            // Perform different forms of acceleration depending on
-                            // the range of the element from its assigned dead zone.
-                            // Useful for more precise controls with an axis.
-                            double temp = difference;
-                            if (temp <= 0.4)
-                            {
-                                // Low slope value for really slow acceleration
-                                difference = (difference * 0.38);
-
-                                // Out of high end. Reset easing status.
-                                if (buttonslot->isEasingActive())
-                                {
-                                    buttonslot->setEasingStatus(false);
-                                    buttonslot->getEasingTime()->restart();
-                                }
-                            }
-                            else if (temp <= 0.75)
+                            if (difference <= 0.75)
                             {
-                                // Perform Linear accleration with an appropriate
-                                // offset.
-                                difference = (difference - 0.248);
+                                // Low and linear segments come from the table.
+                                difference = lookupMouseCurve(currentCurve, difference);
 
                                 // Out of high end. Reset easing status.
                                 if (buttonslot->isEasingActive())
@@ -1277,9 +1239,16 @@ void JoyButton::mouseEvent()
                                 difference = (difference * 1.33067 - 0.496005);
                             }
                             break;
-                       }
-                    default:
-                        break;
+                        }
+                        case LinearCurve:
+                        {
+                            break;
+                        }
+                        default:
+                        {
+                            difference = lookupMouseCurve(currentCurve, difference);
+                            break;
+                        }
                     }
 
                     double distance = 0;
@@ -1309,7 +1278,7 @@ void JoyButton::mouseEvent()
                         if (extraAccelCurve == EaseOutSineCurve)
                         {
                             double getMultiDiff2 = ((currentAccelMultiTemp - minfactor) / (extraAccelerationMultiplier - minfactor));
-                            currentAccelMultiTemp = (extraAccelerationMultiplier - minfactor) * sin(getMultiDiff2 * (GlobalVariables::JoyControlStick::PI/2.0)) + minfactor;
+                            currentAccelMultiTemp = (extraAccelerationMultiplier - minfactor) * easeOutSine(getMultiDiff2) + minfactor;
                         }
                         else if (extraAccelCurve == EaseOutQuadAccelCurve)
                         {
@@ -1361,9 +1330,9 @@ void JoyButton::mouseEvent()
                             case EaseOutSineCurve:
                             {
                                 double multiDiff = ((currentAccelMultiTemp - minfactor) / (extraAccelerationMultiplier - minfactor));
-                                double temp = sin(multiDiff * (GlobalVariables::JoyControlStick::PI/2.0));
+                                double temp = easeOutSine(multiDiff);
                                 elapsedDuration = accelDuration * temp + 0;
-                                currentAccelMultiTemp = (extraAccelerationMultiplier - minfactor) * sin(multiDiff * (GlobalVariables::JoyControlStick::PI/2.0)) + minfactor;
+                                currentAccelMultiTemp = (extraAccelerationMultiplier - minfactor) * temp + minfactor;
 
                                 break;
                             }
@@ -1490,21 +1459,23 @@ void JoyButton::mouseEvent()
                     updateMouseProperties(mouse2, 0.0, springWidth, springHeight, relativeSpring, GlobalVariables::JoyButton::springModeScreen, springYSpeeds, 'Y');
                     mouseInterval->restart();
                 }
-
-                tempQueue.enqueue(buttonslot);
             }
 
-            if (!mouseEventQueue.isEmpty() && !singleShot) buttonslot = mouseEventQueue.dequeue();
-            else buttonslot = nullptr;
-
-        }
+            if (singleShot)
+            {
+                if (isActive)
+                    mouseEventQueue.enqueue(buttonslot);
 
-        if (!tempQueue.isEmpty())
-        {
-            while (!tempQueue.isEmpty())
+                buttonslot = nullptr;
+            }
+            else
             {
-                JoyButtonSlot *tempslot = tempQueue.dequeue();
-                mouseEventQueue.enqueue(tempslot);
+                if (isActive)
+                    queueIndex++;
+                else
+                    mouseEventQueue.removeAt(queueIndex);
+
+                buttonslot = (queueIndex < mouseEventQueue.length()) ? mouseEventQueue.at(queueIndex) : nullptr;
             }
         }
     }
@@ -1523,7 +1494,7 @@ void JoyButton::setDistanceForSpring(JoyButtonMouseHelper& mouseHelper, double&
 }
 
 
-void JoyButton::updateMouseProperties(double newAxisValue, double newSpringDead, int newSpringWidth, int newSpringHeight, bool relatived, int modeScreen, QList<PadderCommon::springModeInfo>& springSpeeds, QChar axis, double newAxisValueY,  double newSpringDeadY)
+void JoyButton::updateMouseProperties(double newAxisValue, double newSpringDead, int newSpringWidth, int newSpringHeight, bool relatived, int modeScreen, JoyButton::springModeList& springSpeeds, QChar axis, double newAxisValueY,  double newSpringDeadY)
 {
     PadderCommon::springModeInfo axisInfo;
 
@@ -1564,14 +1535,13 @@ void JoyButton::wheelEventVertical()
 
     if (buttonslot && (wheelSpeedY != 0))
     {
-        bool isActive = getActiveSlots().contains(buttonslot);
+        bool isActive = buttonslot->isActive();
 
         if (isActive)
         {
-            sendevent(buttonslot, true);
-            sendevent(buttonslot, false);
+            sendWheelStep(buttonslot, true);
             mouseWheelVerticalEventQueue.enqueue(buttonslot);
-            mouseWheelVerticalEventTimer.start(1000 / wheelSpeedY);
+            mouseWheelVerticalEventTimer.start(1000 / (wheelSpeedY * getWheelStepsPerNotch()));
         }
         else
         {
@@ -1585,12 +1555,11 @@ void JoyButton::wheelEventVertical()
         while (!mouseWheelVerticalEventQueue.isEmpty())
         {
             buttonslot = mouseWheelVerticalEventQueue.dequeue();
-            bool isActive = getActiveSlots().contains(buttonslot);
+            bool isActive = buttonslot->isActive();
 
             if (isActive)
             {
-                sendevent(buttonslot, true);
-                sendevent(buttonslot, false);
+                sendWheelStep(buttonslot);
                 tempQueue.enqueue(buttonslot);
             }
         }
@@ -1598,7 +1567,7 @@ void JoyButton::wheelEventVertical()
         if (!tempQueue.isEmpty())
         {
             mouseWheelVerticalEventQueue = tempQueue;
-            mouseWheelVerticalEventTimer.start(1000 / wheelSpeedY);
+            mouseWheelVerticalEventTimer.start(1000 / (wheelSpeedY * getWheelStepsPerNotch()));
         }
         else
         {
@@ -1611,6 +1580,28 @@ void JoyButton::wheelEventVertical()
     }
 }
 
+/**
+ * @brief Scroll by one wheel timer tick. That is a whole notch unless
+ *     high resolution output splits it into WHEELHIRESSTEPS parts.
+ *     Pressing the button always scrolls a whole notch so a short tap
+ *     still reaches programs that only read legacy wheel events.
+ * @param Mouse wheel slot
+ * @param Whether the step is the first one of a button press
+ */
+void JoyButton::sendWheelStep(JoyButtonSlot *slot, bool pressed)
+{
+    if (isHighResolutionOutput())
+    {
+        int units = pressed ? 120 : (120 / WHEELHIRESSTEPS);
+        EventHandlerFactory::getInstance()->handler()->sendMouseWheelEvent(slot, units);
+    }
+    else
+    {
+        sendevent(slot, true);
+        sendevent(slot, false);
+    }
+}
+
 void JoyButton::wheelEventHorizontal()
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
@@ -1622,14 +1613,13 @@ void JoyButton::wheelEventHorizontal()
 
     if (buttonslot && (wheelSpeedX != 0))
     {
-        bool isActive = getActiveSlots().contains(buttonslot);
+        bool isActive = buttonslot->isActive();
 
         if (isActive)
         {
-            sendevent(buttonslot, true);
-            sendevent(buttonslot, false);
+            sendWheelStep(buttonslot, true);
             mouseWheelHorizontalEventQueue.enqueue(buttonslot);
-            mouseWheelHorizontalEventTimer.start(1000 / wheelSpeedX);
+            mouseWheelHorizontalEventTimer.start(1000 / (wheelSpeedX * getWheelStepsPerNotch()));
         }
         else
         {
@@ -1643,12 +1633,11 @@ void JoyButton::wheelEventHorizontal()
         while (!mouseWheelHorizontalEventQueue.isEmpty())
         {
             buttonslot = mouseWheelHorizontalEventQueue.dequeue();
-            bool isActive = getActiveSlots().contains(buttonslot);
+            bool isActive = buttonslot->isActive();
 
             if (isActive)
             {
-                sendevent(buttonslot, true);
-                sendevent(buttonslot, false);
+                sendWheelStep(buttonslot);
                 tempQueue.enqueue(buttonslot);
             }
         }
@@ -1656,7 +1645,7 @@ void JoyButton::wheelEventHorizontal()
         if (!tempQueue.isEmpty())
         {
             mouseWheelHorizontalEventQueue = tempQueue;
-            mouseWheelHorizontalEventTimer.start(1000 / wheelSpeedX);
+            mouseWheelHorizontalEventTimer.start(1000 / (wheelSpeedX * getWheelStepsPerNotch()));
         }
         else
         {
@@ -3460,6 +3449,11 @@ void JoyButton::releaseActiveSlots()
             }
         }
 
+        for (JoyButtonSlot *slot : getActiveSlots())
+        {
+            slot->setActiveStatus(false);
+        }
+
         getActiveSlotsLocal().clear();
         currentMouseEvent = nullptr;
 
@@ -3494,6 +3488,8 @@ void JoyButton::releaseActiveSlots()
         {
             GlobalVariables::JoyButton::cursorRemainderX = 0;
             GlobalVariables::JoyButton::cursorRemainderY = 0;
+            GlobalVariables::JoyButton::cursorSubPixelX = 0;
+            GlobalVariables::JoyButton::cursorSubPixelY = 0;
         }
 
         activeZoneTimer.start();
@@ -3539,10 +3535,8 @@ void JoyButton::releaseEachSlot(bool& changeRepeatState, int& references, int te
 
         if (mousemode == MouseCursor)
         {
-            QList<int> indexesToRemove;
-
-            releaseMoveSlots(cursorXSpeeds, slot, indexesToRemove);
-            releaseMoveSlots(cursorYSpeeds, slot, indexesToRemove);
+            releaseMoveSlots(cursorXSpeeds, slot);
+            releaseMoveSlots(cursorYSpeeds, slot);
             slot->getEasingTime()->restart();
             slot->setEasingStatus(false);
         }
@@ -3627,26 +3621,13 @@ void JoyButton::checkSpringDeadCircle(int tempcode, double& springDeadCircle, in
     }
 }
 
-void JoyButton::releaseMoveSlots(QList<JoyButton::mouseCursorInfo>& cursorSpeeds, JoyButtonSlot *slot, QList<int>& indexesToRemove)
+void JoyButton::releaseMoveSlots(JoyButton::mouseCursorList& cursorSpeeds, JoyButtonSlot *slot)
 {
-    QListIterator<mouseCursorInfo> iter(cursorSpeeds);
-    int i = cursorSpeeds.length();
-
-    while (iter.hasNext())
-    {
-        mouseCursorInfo info = iter.next();
-        if (info.slot == slot) indexesToRemove.append(i);
-        i++;
-    }
-
-    QListIterator<int> removeIter(indexesToRemove);
-    while (removeIter.hasPrevious())
+    for (int i = cursorSpeeds.length() - 1; i >= 0; i--)
     {
-        int index = removeIter.previous();
-        cursorSpeeds.removeAt(index);
+        if (cursorSpeeds.at(i).slot == slot)
+            cursorSpeeds.removeAt(i);
     }
-
-    indexesToRemove.clear();
 }
 
 bool JoyButton::containsReleaseSlots()
@@ -3829,6 +3810,7 @@ bool JoyButton::isDefault()
     value = value && (getAssignedSlots()->isEmpty());
     value = value && (mouseMode == DEFAULTMOUSEMODE);
     value = value && (mouseCurve == DEFAULTMOUSECURVE);
+    value = value && (getCustomMouseCurveSnapshot()->isEmpty());
     value = value && (springWidth == GlobalVariables::JoyButton::DEFAULTSPRINGWIDTH);
     value = value && (springHeight == GlobalVariables::JoyButton::DEFAULTSPRINGHEIGHT);
     value = value && qFuzzyCompare(sensitivity, GlobalVariables::JoyButton::DEFAULTSENSITIVITY);
@@ -3895,6 +3877,46 @@ JoyButton::JoyMouseCurve JoyButton::getMouseCurve()
     return mouseCurve;
 }
 
+/**
+ * @brief Set the control points used when the mouse curve is
+ *     CustomCurve. The lookup table is rebuilt on the next mouse event.
+ */
+void JoyButton::setCustomMouseCurve(ResponseCurve const& curve)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    if (curve != *getCustomMouseCurveSnapshot())
+    {
+        QSharedPointer<const ResponseCurve> tempCurve(new ResponseCurve(curve));
+
+        customMouseCurveMutex.lock();
+        customMouseCurve = tempCurve;
+        customMouseCurveMutex.unlock();
+
+        emit propertyUpdated();
+    }
+}
+
+ResponseCurve JoyButton::getCustomMouseCurve()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    return *getCustomMouseCurveSnapshot();
+}
+
+/**
+ * @brief Custom mouse curve that is currently published. The curve is
+ *     never changed, so it can be used after a newer one was set.
+ */
+QSharedPointer<const ResponseCurve> JoyButton::getCustomMouseCurveSnapshot()
+{
+    customMouseCurveMutex.lock();
+    QSharedPointer<const ResponseCurve> tempCurve = customMouseCurve;
+    customMouseCurveMutex.unlock();
+
+    return tempCurve;
+}
+
 void JoyButton::setSpringWidth(int value)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
@@ -4047,7 +4069,7 @@ QString JoyButton::getDefaultButtonName()
  * @brief Take cursor mouse information provided by all buttons and
  *     send a cursor mode mouse event to the display server.
  */
-void JoyButton::moveMouseCursor(int &movedX, int &movedY, int &movedElapsed, QList<double>* mouseHistoryX, QList<double>* mouseHistoryY, QTime* testOldMouseTime, QTimer* staticMouseEventTimer, int mouseRefreshRate, int mouseHistorySize, QList<JoyButton::mouseCursorInfo>* cursorXSpeeds, QList<JoyButton::mouseCursorInfo>* cursorYSpeeds, double& cursorRemainderX, double& cursorRemainderY, double weightModifier, int idleMouseRefrRate, QList<JoyButton*>* pendingMouseButtons)
+void JoyButton::moveMouseCursor(int &movedX, int &movedY, int &movedElapsed, QList<double>* mouseHistoryX, QList<double>* mouseHistoryY, QTime* testOldMouseTime, QTimer* staticMouseEventTimer, int mouseRefreshRate, int mouseHistorySize, JoyButton::mouseCursorList* cursorXSpeeds, JoyButton::mouseCursorList* cursorYSpeeds, double& cursorRemainderX, double& cursorRemainderY, qint64& cursorSubPixelX, qint64& cursorSubPixelY, bool highResolution, double weightModifier, int idleMouseRefrRate, QList<JoyButton*>* pendingMouseButtons)
 {
    // qInstallMessageHandler(MessageHandler::myMessageOutput);
 
@@ -4080,8 +4102,8 @@ void JoyButton::moveMouseCursor(int &movedX, int &movedY, int &movedElapsed, QLi
 
         for (int i = 0; i < queueLength; i++)
         {
-            mouseCursorInfo infoX = cursorXSpeeds->takeFirst();
-            mouseCursorInfo infoY = cursorYSpeeds->takeFirst();
+            mouseCursorInfo const& infoX = cursorXSpeeds->at(i);
+            mouseCursorInfo const& infoY = cursorYSpeeds->at(i);
 
             distanceForMovingAx(finalx, infoX);
             distanceForMovingAx(finaly, infoY);
@@ -4090,22 +4112,26 @@ void JoyButton::moveMouseCursor(int &movedX, int &movedY, int &movedElapsed, QLi
             infoY.slot->getMouseInterval()->restart();
         }
 
-        // Only apply remainder if both current displacement and remainder
-        // follow the same direction.
-        if ((cursorRemainderX >= 0) == (finalx >= 0)) finalx += cursorRemainderX;
-
-        // Cap maximum relative mouse movement.
-        if (abs(finalx) > 127) finalx = (finalx < 0) ? -127 : 127;
+        // High resolution output carries the remainder in the sub-pixel
+        // accumulators below and is not capped.
+        if (!highResolution)
+        {
+            // Only apply remainder if both current displacement and remainder
+            // follow the same direction.
+            if ((cursorRemainderX >= 0) == (finalx >= 0)) finalx += cursorRemainderX;
 
-        mouseHistoryX->prepend(finalx);
+            // Cap maximum relative mouse movement.
+            if (abs(finalx) > 127) finalx = (finalx < 0) ? -127 : 127;
 
-        // Only apply remainder if both current displacement and remainder
-        // follow the same direction.
-        if ((cursorRemainderY >= 0) == (finaly >= 0)) finaly += cursorRemainderY;
+            // Only apply remainder if both current displacement and remainder
+            // follow the same direction.
+            if ((cursorRemainderY >= 0) == (finaly >= 0)) finaly += cursorRemainderY;
 
-        // Cap maximum relative mouse movement.
-        if (abs(finaly) > 127) finaly = (finaly < 0) ? -127 : 127;
+            // Cap maximum relative mouse movement.
+            if (abs(finaly) > 127) finaly = (finaly < 0) ? -127 : 127;
+        }
 
+        mouseHistoryX->prepend(finalx);
         mouseHistoryY->prepend(finaly);
 
         cursorRemainderX = 0;
@@ -4116,6 +4142,14 @@ void JoyButton::moveMouseCursor(int &movedX, int &movedY, int &movedElapsed, QLi
         adjustAxForCursor(mouseHistoryX, adjustedX, cursorRemainderX, weightModifier);
         adjustAxForCursor(mouseHistoryY, adjustedY, cursorRemainderY, weightModifier);
 
+        if (highResolution)
+        {
+            adjustedX = accumulateSubPixel(adjustedX + cursorRemainderX, cursorSubPixelX);
+            adjustedY = accumulateSubPixel(adjustedY + cursorRemainderY, cursorSubPixelY);
+            cursorRemainderX = 0;
+            cursorRemainderY = 0;
+        }
+
         // This check is more of a precaution than anything. No need to cause
         // a sync to happen when not needed.
         if (!qFuzzyIsNull(adjustedX) || !qFuzzyIsNull(adjustedY))
@@ -4151,6 +4185,8 @@ void JoyButton::moveMouseCursor(int &movedX, int &movedY, int &movedElapsed, QLi
 
         cursorRemainderX = 0;
         cursorRemainderY = 0;
+        cursorSubPixelX = 0;
+        cursorSubPixelY = 0;
     }
     else
     {
@@ -4162,7 +4198,7 @@ void JoyButton::moveMouseCursor(int &movedX, int &movedY, int &movedElapsed, QLi
     cursorYSpeeds->clear();
 }
 
-void JoyButton::distanceForMovingAx(double& finalAx, mouseCursorInfo infoAx)
+void JoyButton::distanceForMovingAx(double& finalAx, mouseCursorInfo const& infoAx)
 {
     if (!qFuzzyIsNull(infoAx.code))
     {
@@ -4197,11 +4233,31 @@ void JoyButton::adjustAxForCursor(QList<double>* mouseHistoryList, double& adjus
     }
 }
 
+/**
+ * @brief Add a cursor distance to a fixed-point sub-pixel accumulator and
+ *     take the whole pixels out of it. The fraction stays in the
+ *     accumulator regardless of direction, so slow movement is not lost.
+ * @param Distance in pixels
+ * @param Accumulator with SUBPIXELBITS fractional bits
+ * @return Whole pixels to move
+ */
+int JoyButton::accumulateSubPixel(double distance, qint64& accumulator)
+{
+    accumulator += qRound64(distance * (1 << SUBPIXELBITS));
+
+    // Integer division truncates toward zero, leaving a remainder with the
+    // sign of the accumulator.
+    qint64 pixels = accumulator / (1 << SUBPIXELBITS);
+    accumulator -= pixels * (1 << SUBPIXELBITS);
+
+    return static_cast<int>(pixels);
+}
+
 /**
  * @brief Take spring mouse information provided by all buttons and
  *     send a spring mode mouse event to the display server.
  */
-void JoyButton::moveSpringMouse(int &movedX, int &movedY, bool &hasMoved, int springModeScreen, QList<PadderCommon::springModeInfo>* springXSpeeds, QList<PadderCommon::springModeInfo>* springYSpeeds, QList<JoyButton*>* pendingMouseButtons, int mouseRefreshRate, int idleMouseRefrRate, QTimer* staticMouseEventTimer)
+void JoyButton::moveSpringMouse(int &movedX, int &movedY, bool &hasMoved, int springModeScreen, JoyButton::springModeList* springXSpeeds, JoyButton::springModeList* springYSpeeds, QList<JoyButton*>* pendingMouseButtons, int mouseRefreshRate, int idleMouseRefrRate, QTimer* staticMouseEventTimer)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
@@ -4230,11 +4286,8 @@ void JoyButton::moveSpringMouse(int &movedX, int &movedY, bool &hasMoved, int sp
             double tempSpringDeadX = 0.0;
             double tempSpringDeadY = 0.0;
 
-            PadderCommon::springModeInfo infoX;
-            PadderCommon::springModeInfo infoY;
-
-            infoX = springXSpeeds->takeLast();
-            infoY = springYSpeeds->takeLast();
+            PadderCommon::springModeInfo const& infoX = springXSpeeds->at(i);
+            PadderCommon::springModeInfo const& infoY = springYSpeeds->at(i);
 
             tempx = infoX.displacementX;
             tempy = infoY.displacementY;
@@ -4585,6 +4638,10 @@ void JoyButton::copyAssignments(JoyButton *destButton)
     destButton->springWidth = springWidth;
     destButton->springHeight = springHeight;
     destButton->sensitivity = sensitivity;
+    QSharedPointer<const ResponseCurve> tempCurve = getCustomMouseCurveSnapshot();
+    destButton->customMouseCurveMutex.lock();
+    destButton->customMouseCurve = tempCurve;
+    destButton->customMouseCurveMutex.unlock();
     destButton->buttonName = buttonName;
     destButton->actionName = actionName;
     destButton->cycleResetActive = cycleResetActive;
@@ -4641,6 +4698,146 @@ bool JoyButton::isPartRealAxis()
     return false;
 }
 
+/**
+ * @brief Apply a mouse curve to a distance from the dead zone. Only the
+ *     time independent part of the easing curves is handled here.
+ * @param Mouse curve
+ * @param Distance from the dead zone in the range of 0.0 to 1.0
+ * @param Sensitivity used by the power curve
+ * @return Adjusted distance
+ */
+double JoyButton::evaluateMouseCurve(JoyMouseCurve curve, double difference, double sensitivity)
+{
+    switch (curve)
+    {
+        case QuadraticCurve:
+        {
+            difference = difference * difference;
+            break;
+        }
+        case CubicCurve:
+        {
+            difference = difference * difference * difference;
+            break;
+        }
+        case QuadraticExtremeCurve:
+        {
+            double temp = difference;
+            difference = difference * difference;
+            difference = (temp >= 0.95) ? (difference * 1.5) : difference;
+            break;
+        }
+        case PowerCurve:
+        {
+            double tempsensitive = qMin(qMax(sensitivity, 1.0e-3), 1.0e+3);
+            difference = qMin(qMax(pow(difference, 1.0 / tempsensitive), 0.0), 1.0);
+            break;
+        }
+        case EnhancedPrecisionCurve:
+        {
+            // Perform different forms of acceleration depending on
+            // the range of the element from its assigned dead zone.
+            // Useful for more precise controls with an axis.
+            if (difference <= 0.4)
+            {
+                // Low slope value for really slow acceleration
+                difference = (difference * 0.37);
+            }
+            else if (difference <= 0.75)
+            {
+                // Perform Linear accleration with an appropriate
+                // offset.
+                difference = (difference - 0.252);
+            }
+            else
+            {
+                // Perform mouse acceleration. Make up the difference
+                // due to the previous two segments. Maxes out at 1.0.
+                difference = (difference * 2.008) - 1.008;
+            }
+
+            break;
+        }
+        case EasingQuadraticCurve:
+        case EasingCubicCurve:
+        {
+            difference = (difference <= 0.4) ? (difference * 0.38) : (difference - 0.248);
+            break;
+        }
+        default:
+        {
+            break;
+        }
+    }
+
+    return difference;
+}
+
+/**
+ * @brief Mouse curve value read from the table of the button. The table
+ *     is rebuilt on the mouse thread whenever the curve, sensitivity or
+ *     custom curve differs from the one it was built for.
+ */
+double JoyButton::lookupMouseCurve(JoyMouseCurve curve, double difference)
+{
+    QSharedPointer<const ResponseCurve> customCurve = getCustomMouseCurveSnapshot();
+
+    if ((difference < 0.0) || (difference > 1.0))
+    {
+        return (curve == CustomCurve) ? customCurve->evaluate(difference) :
+                                        evaluateMouseCurve(curve, difference, sensitivity);
+    }
+
+    if (mouseCurveTable.isEmpty() || (mouseCurveTableCurve != curve) ||
+        (mouseCurveTableSensitivity != sensitivity) ||
+        (mouseCurveTableCustomCurve != customCurve))
+    {
+        if (curve == CustomCurve)
+        {
+            customCurve->fillTable(mouseCurveTable);
+        }
+        else
+        {
+            for (int i = 0; i <= ResponseCurveTable::SEGMENTS; i++)
+            {
+                mouseCurveTable.setPoint(i, evaluateMouseCurve(curve, ResponseCurveTable::inputForPoint(i), sensitivity));
+            }
+        }
+
+        mouseCurveTableCurve = curve;
+        mouseCurveTableSensitivity = sensitivity;
+        mouseCurveTableCustomCurve = customCurve;
+    }
+
+    return mouseCurveTable.lookup(difference);
+}
+
+static ResponseCurveTable buildEaseOutSineTable()
+{
+    ResponseCurveTable table;
+
+    for (int i = 0; i <= ResponseCurveTable::SEGMENTS; i++)
+    {
+        table.setPoint(i, sin(ResponseCurveTable::inputForPoint(i) * (GlobalVariables::JoyControlStick::PI/2.0)));
+    }
+
+    return table;
+}
+
+/**
+ * @brief Ease out sine used by the extra acceleration curves. Values
+ *     outside of 0.0 to 1.0 are calculated directly.
+ */
+double JoyButton::easeOutSine(double value)
+{
+    static const ResponseCurveTable sineTable = buildEaseOutSineTable();
+
+    if ((value < 0.0) || (value > 1.0))
+        return sin(value * (GlobalVariables::JoyControlStick::PI/2.0));
+
+    return sineTable.lookup(value);
+}
+
 /**
  * @brief Calculate maximum mouse speed when using a given mouse curve.
  * @param Mouse curve
@@ -4709,25 +4906,25 @@ QList<JoyButton*>* JoyButton::getPendingMouseButtons()
 }
 
 
-QList<JoyButton::mouseCursorInfo>* JoyButton::getCursorXSpeeds()
+JoyButton::mouseCursorList* JoyButton::getCursorXSpeeds()
 {
     return &cursorXSpeeds;
 }
 
 
-QList<JoyButton::mouseCursorInfo>* JoyButton::getCursorYSpeeds()
+JoyButton::mouseCursorList* JoyButton::getCursorYSpeeds()
 {
     return &cursorYSpeeds;
 }
 
 
-QList<PadderCommon::springModeInfo>* JoyButton::getSpringXSpeeds()
+JoyButton::springModeList* JoyButton::getSpringXSpeeds()
 {
     return &springXSpeeds;
 }
 
 
-QList<PadderCommon::springModeInfo>* JoyButton::getSpringYSpeeds()
+JoyButton::springModeList* JoyButton::getSpringYSpeeds()
 {
     return &springYSpeeds;
 }
@@ -4745,7 +4942,7 @@ QTime* JoyButton::getTestOldMouseTime()
 }
 
 
-bool JoyButton::hasCursorEvents(QList<JoyButton::mouseCursorInfo>* cursorXSpeedsList, QList<JoyButton::mouseCursorInfo>* cursorYSpeedsList)
+bool JoyButton::hasCursorEvents(JoyButton::mouseCursorList* cursorXSpeedsList, JoyButton::mouseCursorList* cursorYSpeedsList)
 {
   //  qInstallMessageHandler(MessageHandler::myMessageOutput);
 
@@ -4753,7 +4950,7 @@ bool JoyButton::hasCursorEvents(QList<JoyButton::mouseCursorInfo>* cursorXSpeeds
 }
 
 
-bool JoyButton::hasSpringEvents(QList<PadderCommon::springModeInfo>* springXSpeedsList, QList<PadderCommon::springModeInfo>* springYSpeedsList)
+bool JoyButton::hasSpringEvents(JoyButton::springModeList* springXSpeedsList, JoyButton::springModeList* springYSpeedsList)
 {
    // qInstallMessageHandler(MessageHandler::myMessageOutput);
 
@@ -4901,6 +5098,9 @@ void JoyButton::resetAllProperties()
     wheelSpeedY = GlobalVariables::JoyButton::DEFAULTWHEELY;
     mouseMode = DEFAULTMOUSEMODE;
     mouseCurve = DEFAULTMOUSECURVE;
+    customMouseCurveMutex.lock();
+    customMouseCurve = QSharedPointer<const ResponseCurve>(new ResponseCurve());
+    customMouseCurveMutex.unlock();
     springWidth = GlobalVariables::JoyButton::DEFAULTSPRINGWIDTH;
     springHeight = GlobalVariables::JoyButton::DEFAULTSPRINGHEIGHT;
     sensitivity = GlobalVariables::JoyButton::DEFAULTSENSITIVITY;
@@ -5112,6 +5312,32 @@ void JoyButton::setSpringModeScreen(int screen, int& springModeScreen)
     if (screen >= -1) springModeScreen = screen;
 }
 
+void JoyButton::setHighResolutionMouse(bool enabled, bool& highResolutionMouse)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    highResolutionMouse = enabled;
+}
+
+/**
+ * @brief Check if high resolution mouse output is enabled and supported by
+ *     the current event handler.
+ * @return Whether relative motion is uncapped and wheel notches are split
+ */
+bool JoyButton::isHighResolutionOutput()
+{
+    return GlobalVariables::JoyButton::highResolutionMouse &&
+           EventHandlerFactory::getInstance()->handler()->hasHighResolutionOutput();
+}
+
+/**
+ * @brief Get number of wheel timer ticks that make up one notch.
+ */
+int JoyButton::getWheelStepsPerNotch()
+{
+    return isHighResolutionOutput() ? WHEELHIRESSTEPS : 1;
+}
+
 void JoyButton::setAccelExtraDuration(double value)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
@@ -5268,3 +5494,9 @@ QList<JoyButtonSlot*>& JoyButton::getActiveSlotsLocal() {
 
     return activeSlots;
 }
+
+void JoyButton::appendActiveSlot(JoyButtonSlot *slot)
+{
+    slot->setActiveStatus(true);
+    activeSlots.append(slot);
+}
@@ -25,11 +25,16 @@
 #include "globalvariables.h"
 #include "springmousemoveinfo.h"
 #include "joybuttonmousehelper.h"
+#include "fixedcapacitylist.h"
+#include "responsecurve.h"
+#include "responsecurvetable.h"
 
 #include <QThread>
 #include <QTimer>
 #include <QQueue>
 #include <QReadWriteLock>
+#include <QMutex>
+#include <QSharedPointer>
 #include <QRunnable>
 #include <QDeadlineTimer>
 
@@ -57,7 +62,7 @@ public:
     enum JoyMouseMovementMode {MouseCursor=0, MouseSpring};
     enum JoyMouseCurve {EnhancedPrecisionCurve=0, LinearCurve, QuadraticCurve,
                         CubicCurve, QuadraticExtremeCurve, PowerCurve,
-                        EasingQuadraticCurve, EasingCubicCurve};
+                        EasingQuadraticCurve, EasingCubicCurve, CustomCurve};
     enum JoyExtraAccelerationCurve {LinearAccelCurve, EaseOutSineCurve,
                                     EaseOutQuadAccelCurve, EaseOutCubicAccelCurve};
     enum TurboMode {NormalTurbo=0, GradientTurbo, PulseTurbo};
@@ -68,6 +73,18 @@ public:
         double code;
     } mouseCursorInfo;
 
+    // Upper bound of mouse movement events gathered during one mouse tick.
+    static const int MAXMOUSEEVENTS = 256;
+
+    typedef FixedCapacityList<mouseCursorInfo, MAXMOUSEEVENTS> mouseCursorList;
+    typedef FixedCapacityList<PadderCommon::springModeInfo, MAXMOUSEEVENTS> springModeList;
+
+    // Fractional bits of the sub-pixel cursor accumulator used in
+    // high resolution mode.
+    static const int SUBPIXELBITS = 16;
+    // Wheel timer ticks per notch in high resolution mode.
+    static const int WHEELHIRESSTEPS = 8;
+
     void joyEvent(bool pressed, bool ignoresets=false); // JoyButtonEvents class
     void queuePendingEvent(bool pressed, bool ignoresets=false); // JoyButtonEvents class
     void activatePendingEvent(); // JoyButtonEvents class
@@ -80,6 +97,8 @@ public:
     void setIgnoreEventState(bool ignore); // JoyButtonEvents class
     void setMouseMode(JoyMouseMovementMode mousemode);
     void setMouseCurve(JoyMouseCurve selectedCurve);
+    void setCustomMouseCurve(ResponseCurve const& curve);
+    ResponseCurve getCustomMouseCurve();
     void setWhileHeldStatus(bool status);
     void setCycleResetStatus(bool enabled);
     void copyAssignments(JoyButton *destButton);
@@ -185,17 +204,21 @@ public:
     TurboMode getTurboMode();
 
     static int calculateFinalMouseSpeed(JoyMouseCurve curve, int value, const float joyspeed);
+    static double evaluateMouseCurve(JoyMouseCurve curve, double difference, double sensitivity);
 
-    static bool hasCursorEvents(QList<JoyButton::mouseCursorInfo>* cursorXSpeedsList, QList<JoyButton::mouseCursorInfo>* cursorYSpeedsList); // JoyButtonEvents class
-    static bool hasSpringEvents(QList<PadderCommon::springModeInfo>* springXSpeedsList, QList<PadderCommon::springModeInfo>* springYSpeedsList); // JoyButtonEvents class
+    static bool hasCursorEvents(JoyButton::mouseCursorList* cursorXSpeedsList, JoyButton::mouseCursorList* cursorYSpeedsList); // JoyButtonEvents class
+    static bool hasSpringEvents(JoyButton::springModeList* springXSpeedsList, JoyButton::springModeList* springYSpeedsList); // JoyButtonEvents class
     static bool shouldInvokeMouseEvents(QList<JoyButton*>* pendingMouseButtons, QTimer* staticMouseEventTimer, QTime* testOldMouseTime); // JoyButtonEvents class
 
     static void setWeightModifier(double modifier, double maxWeightModifier, double& weightModifier);
-    static void moveMouseCursor(int &movedX, int &movedY, int &movedElapsed, QList<double>* mouseHistoryX, QList<double>* mouseHistoryY, QTime* testOldMouseTime, QTimer* staticMouseEventTimer, int mouseRefreshRate, int mouseHistorySize, QList<JoyButton::mouseCursorInfo>* cursorXSpeeds, QList<JoyButton::mouseCursorInfo>* cursorYSpeeds, double& cursorRemainderX, double& cursorRemainderY, double weightModifier, int idleMouseRefrRate, QList<JoyButton*>* pendingMouseButtonse);
-    static void moveSpringMouse(int &movedX, int &movedY, bool &hasMoved, int springModeScreen, QList<PadderCommon::springModeInfo>* springXSpeeds, QList<PadderCommon::springModeInfo>* springYSpeeds, QList<JoyButton*>* pendingMouseButtons, int mouseRefreshRate, int idleMouseRefrRate, QTimer* staticMouseEventTimer);
+    static void moveMouseCursor(int &movedX, int &movedY, int &movedElapsed, QList<double>* mouseHistoryX, QList<double>* mouseHistoryY, QTime* testOldMouseTime, QTimer* staticMouseEventTimer, int mouseRefreshRate, int mouseHistorySize, JoyButton::mouseCursorList* cursorXSpeeds, JoyButton::mouseCursorList* cursorYSpeeds, double& cursorRemainderX, double& cursorRemainderY, qint64& cursorSubPixelX, qint64& cursorSubPixelY, bool highResolution, double weightModifier, int idleMouseRefrRate, QList<JoyButton*>* pendingMouseButtonse);
+    static void moveSpringMouse(int &movedX, int &movedY, bool &hasMoved, int springModeScreen, JoyButton::springModeList* springXSpeeds, JoyButton::springModeList* springYSpeeds, QList<JoyButton*>* pendingMouseButtons, int mouseRefreshRate, int idleMouseRefrRate, QTimer* staticMouseEventTimer);
     static void setMouseHistorySize(int size, int maxMouseHistSize, int& mouseHistSize, QList<double>* mouseHistoryX, QList<double>* mouseHistoryY);
     static void setMouseRefreshRate(int refresh, int& mouseRefreshRate, int idleMouseRefrRate, JoyButtonMouseHelper* mouseHelper, QList<double>* mouseHistoryX, QList<double>* mouseHistoryY, QTime* testOldMouseTime, QTimer* staticMouseEventTimer);
     static void setSpringModeScreen(int screen, int& springModeScreen);
+    static void setHighResolutionMouse(bool enabled, bool& highResolutionMouse);
+    static bool isHighResolutionOutput();
+    static int getWheelStepsPerNotch();
     static void resetActiveButtonMouseDistances(JoyButtonMouseHelper* mouseHelper);
     static void setGamepadRefreshRate(int refresh, int& gamepadRefreshRate, JoyButtonMouseHelper* mouseHelper);
     static void restartLastMouseTime(QTime* testOldMouseTime);
@@ -205,10 +228,10 @@ public:
 
     static JoyButtonMouseHelper* getMouseHelper();
     static QList<JoyButton*>* getPendingMouseButtons();
-    static QList<JoyButton::mouseCursorInfo>* getCursorXSpeeds();
-    static QList<JoyButton::mouseCursorInfo>* getCursorYSpeeds();
-    static QList<PadderCommon::springModeInfo>* getSpringXSpeeds();
-    static QList<PadderCommon::springModeInfo>* getSpringYSpeeds();
+    static JoyButton::mouseCursorList* getCursorXSpeeds();
+    static JoyButton::mouseCursorList* getCursorYSpeeds();
+    static JoyButton::springModeList* getSpringXSpeeds();
+    static JoyButton::springModeList* getSpringYSpeeds();
     static QTimer* getStaticMouseEventTimer(); // JoyButtonEvents class
     static QTime* getTestOldMouseTime();
 
@@ -249,10 +272,10 @@ protected:
     QString buildActiveZoneSummary(QList<JoyButtonSlot*> &tempList);
 
     static QList<JoyButtonSlot*> mouseSpeedModList; // JoyButtonSlots class
-    static QList<mouseCursorInfo> cursorXSpeeds;
-    static QList<mouseCursorInfo> cursorYSpeeds;
-    static QList<PadderCommon::springModeInfo> springXSpeeds;
-    static QList<PadderCommon::springModeInfo> springYSpeeds;
+    static mouseCursorList cursorXSpeeds;
+    static mouseCursorList cursorYSpeeds;
+    static springModeList springXSpeeds;
+    static springModeList springYSpeeds;
     static QList<JoyButton*> pendingMouseButtons;
     static JoyButtonSlot *lastActiveKey; // JoyButtonSlots class
     static JoyButtonMouseHelper mouseHelper;
@@ -352,6 +375,7 @@ public slots:
                             JoyButtonSlot::JoySlotInputAction mode=JoyButtonSlot::JoyKeyboard); // JoyButtonSlots class
 
     void buildActiveZoneSummaryString();
+    void sendWheelStep(JoyButtonSlot *slot, bool pressed=false); // JoyButtonEvents class
 
 protected slots:
     virtual void turboEvent(); // JoyButtonEvents class
@@ -486,18 +510,20 @@ private:
     void findJoySlotsEnd(QListIterator<JoyButtonSlot*> *slotiter);
     void changeStatesQueue(bool currentReleased);
     void countActiveSlots(int tempcode, int& references, JoyButtonSlot* slot, QHash<int, int>& activeSlotsHash, bool& changeRepeatState, bool activeSlotHashWindows = false); // JoyButtonSlots class
-    void releaseMoveSlots(QList<JoyButton::mouseCursorInfo>& cursorSpeeds, JoyButtonSlot *slot, QList<int>& indexesToRemove); // JoyButtonSlots class
+    void releaseMoveSlots(JoyButton::mouseCursorList& cursorSpeeds, JoyButtonSlot *slot); // JoyButtonSlots class
     void setSpringDeadCircle(double& springDeadCircle, int mouseDirection);
     void checkSpringDeadCircle(int tempcode, double& springDeadCircle, int mouseSlot1, int mouseSlot2);
-    static void distanceForMovingAx(double& finalAx, mouseCursorInfo infoAx);
+    static void distanceForMovingAx(double& finalAx, mouseCursorInfo const& infoAx);
     static void adjustAxForCursor(QList<double>* mouseHistoryList, double& adjustedAx, double& cursorRemainder, double weightModifier);
+    static int accumulateSubPixel(double distance, qint64& accumulator);
     void setDistanceForSpring(JoyButtonMouseHelper& mouseHelper, double& mouseFirstAx, double& mouseSecondAx, double distanceFromDeadZone);
     void changeTurboParams(bool _isKeyPressed, bool isButtonPressed);
     void updateParamsAfterDistEvent(); // JoyButtonEvents class
     void startSequenceOfPressActive(bool isTurbo, QString debugText);
     QList<JoyButtonSlot*>& getAssignmentsLocal();
     QList<JoyButtonSlot*>& getActiveSlotsLocal(); // JoyButtonSlots class
-    void updateMouseProperties(double newAxisValue, double newSpringDead, int newSpringWidth, int newSpringHeight, bool relatived, int modeScreen, QList<PadderCommon::springModeInfo>& springSpeeds, QChar axis, double newAxisValueY = 0,  double newSpringDeadY = 0);
+    void appendActiveSlot(JoyButtonSlot *slot); // JoyButtonSlots class
+    void updateMouseProperties(double newAxisValue, double newSpringDead, int newSpringWidth, int newSpringHeight, bool relatived, int modeScreen, JoyButton::springModeList& springSpeeds, QChar axis, double newAxisValueY = 0,  double newSpringDeadY = 0);
     //void getActiveZoneWithAppend(JoyButtonSlot::JoySlotInputAction mode, QList<JoyButtonSlot *>& tempSlotList, QListIterator<JoyButtonSlot *> *iter, JoyButtonSlot *slot);
     void buildActiveZoneSummarySwitchSlots(JoyButtonSlot::JoySlotInputAction mode, JoyButtonSlot *slot, bool& behindHold, QStringList* stringlist, int& i, QListIterator<JoyButtonSlot*>* iter, bool slotsActive);
 
@@ -592,12 +618,27 @@ private:
     JoyMouseCurve mouseCurve;
     JoyExtraAccelerationCurve extraAccelCurve;
 
+    // Only touched from mouseEvent on the mouse thread.
+    ResponseCurveTable mouseCurveTable;
+    JoyMouseCurve mouseCurveTableCurve;
+    double mouseCurveTableSensitivity;
+    QSharedPointer<const ResponseCurve> mouseCurveTableCustomCurve;
+
+    // Replaced as a whole under customMouseCurveMutex and never changed
+    // once published, so the mouse thread can keep using its copy.
+    QSharedPointer<const ResponseCurve> customMouseCurve;
+    QMutex customMouseCurveMutex;
+
     QReadWriteLock activeZoneLock;
     QReadWriteLock assignmentsLock;
     QReadWriteLock activeZoneStringLock;
     QThreadPool *threadPool;
 
 
+    QSharedPointer<const ResponseCurve> getCustomMouseCurveSnapshot();
+    double lookupMouseCurve(JoyMouseCurve curve, double difference);
+    static double easeOutSine(double value);
+
     void addEachSlotToActives(JoyButtonSlot *slot, int &i, bool &delaySequence, bool &exit, QListIterator<JoyButtonSlot *> *slotiter);
 };
 
@@ -21,6 +21,8 @@
 #include "globalvariables.h"
 #include "messagehandler.h"
 #include "joybutton.h"
+#include "inputmetrics.h"
+#include "eventhandlerfactory.h"
 
 #include <QDebug>
 #include <QList>
@@ -44,7 +46,7 @@ void JoyButtonMouseHelper::moveMouseCursor()
     int finalx = 0;
     int finaly = 0;
     int elapsedTime = 5;
-    JoyButton::moveMouseCursor(finalx, finaly, elapsedTime, &GlobalVariables::JoyButton::mouseHistoryX, &GlobalVariables::JoyButton::mouseHistoryY, JoyButton::getTestOldMouseTime(), JoyButton::getStaticMouseEventTimer(), GlobalVariables::JoyButton::mouseRefreshRate, GlobalVariables::JoyButton::mouseHistorySize, JoyButton::getCursorXSpeeds(), JoyButton::getCursorYSpeeds(), GlobalVariables::JoyButton::cursorRemainderX, GlobalVariables::JoyButton::cursorRemainderY, GlobalVariables::JoyButton::weightModifier, GlobalVariables::JoyButton::IDLEMOUSEREFRESHRATE, JoyButton::getPendingMouseButtons());
+    JoyButton::moveMouseCursor(finalx, finaly, elapsedTime, &GlobalVariables::JoyButton::mouseHistoryX, &GlobalVariables::JoyButton::mouseHistoryY, JoyButton::getTestOldMouseTime(), JoyButton::getStaticMouseEventTimer(), GlobalVariables::JoyButton::mouseRefreshRate, GlobalVariables::JoyButton::mouseHistorySize, JoyButton::getCursorXSpeeds(), JoyButton::getCursorYSpeeds(), GlobalVariables::JoyButton::cursorRemainderX, GlobalVariables::JoyButton::cursorRemainderY, GlobalVariables::JoyButton::cursorSubPixelX, GlobalVariables::JoyButton::cursorSubPixelY, JoyButton::isHighResolutionOutput(), GlobalVariables::JoyButton::weightModifier, GlobalVariables::JoyButton::IDLEMOUSEREFRESHRATE, JoyButton::getPendingMouseButtons());
 
     if ((finalx != 0) || (finaly != 0))
         emit mouseCursorMoved(finalx, finaly, elapsedTime);
@@ -73,6 +75,11 @@ void JoyButtonMouseHelper::mouseEvent()
 {
    // qInstallMessageHandler(MessageHandler::myMessageOutput);
 
+    InputMetrics::countMouseTick(JoyButton::getStaticMouseEventTimer()->interval());
+
+    BaseEventHandler *handler = EventHandlerFactory::getInstance()->handler();
+    handler->beginOutputFrame();
+
     if (!JoyButton::hasCursorEvents(JoyButton::getCursorXSpeeds(), JoyButton::getCursorYSpeeds()) && !JoyButton::hasSpringEvents(JoyButton::getSpringXSpeeds(), JoyButton::getSpringYSpeeds()))
     {
         QList<JoyButton*> *buttonList = JoyButton::getPendingMouseButtons();
@@ -94,6 +101,8 @@ void JoyButtonMouseHelper::mouseEvent()
 
     JoyButton::restartLastMouseTime(JoyButton::getTestOldMouseTime());
     firstSpringEvent = false;
+
+    handler->endOutputFrame();
 }
 
 void JoyButtonMouseHelper::resetButtonMouseDistances()
@@ -23,10 +23,12 @@
 #include "inputdevice.h"
 #include "antkeymapper.h"
 #include "event.h"
+#include "eventhandlerfactory.h"
 
 
 #include <QDebug>
 #include <QFileInfo>
+#include <QMutexLocker>
 
 
 JoyButtonSlot::JoyButtonSlot(QObject *parent) :
@@ -41,6 +43,7 @@ JoyButtonSlot::JoyButtonSlot(QObject *parent) :
     previousDistance = 0.0;
     qkeyaliasCode = 0;
     easingActive = false;
+    activeStatus = false;
     mix_slots = nullptr;
 }
 
@@ -58,6 +61,7 @@ JoyButtonSlot::JoyButtonSlot(int code, JoySlotInputAction mode, QObject *parent)
     m_mode = mode;
     m_distance = 0.0;
     easingActive = false;
+    activeStatus = false;
     mix_slots = nullptr;
 }
 
@@ -77,6 +81,7 @@ JoyButtonSlot::JoyButtonSlot(int code, int alias, JoySlotInputAction mode, QObje
     m_mode = mode;
     m_distance = 0.0;
     easingActive = false;
+    activeStatus = false;
     mix_slots = nullptr;
 }
 
@@ -92,6 +97,7 @@ JoyButtonSlot::JoyButtonSlot(JoyButtonSlot *slot, QObject *parent) :
     this->m_distance = slot->getDistance();
     this->previousDistance = slot->getPreviousDistance();
     this->easingActive = slot->isEasingActive();
+    this->activeStatus = false;
     this->easingTime.fromString(slot->getEasingTime()->toString());
     this->extraData = slot->getExtraData();
 
@@ -111,6 +117,8 @@ JoyButtonSlot::JoyButtonSlot(JoyButtonSlot *slot, QObject *parent) :
 
     if (!slot->getTextData().isNull() ^ (slot->getTextData() != ""))
         this->m_textData = slot->getTextData();
+
+    compileTextEntryPlan();
 }
 
 JoyButtonSlot::JoyButtonSlot(QString text, JoySlotInputAction mode, QObject *parent) :
@@ -124,6 +132,7 @@ JoyButtonSlot::JoyButtonSlot(QString text, JoySlotInputAction mode, QObject *par
     m_mode = mode;
     m_distance = 0.0;
     easingActive = false;
+    activeStatus = false;
     mix_slots = nullptr;
 
     if ((mode == JoyLoadProfile) ||
@@ -132,6 +141,8 @@ JoyButtonSlot::JoyButtonSlot(QString text, JoySlotInputAction mode, QObject *par
     {
         m_textData = text;
     }
+
+    compileTextEntryPlan();
 }
 
 JoyButtonSlot::~JoyButtonSlot()
@@ -186,6 +197,7 @@ void JoyButtonSlot::setSlotMode(JoySlotInputAction selectedMode)
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
     m_mode = selectedMode;
+    compileTextEntryPlan();
 }
 
 JoyButtonSlot::JoySlotInputAction JoyButtonSlot::getSlotMode()
@@ -542,6 +554,20 @@ void JoyButtonSlot::setEasingStatus(bool isActive)
     easingActive = isActive;
 }
 
+/**
+ * @brief Whether the slot is currently in the active slot list of its
+ *     button. Lets the mouse and wheel events skip a list scan per tick.
+ */
+bool JoyButtonSlot::isActive() const
+{
+    return activeStatus;
+}
+
+void JoyButtonSlot::setActiveStatus(bool active)
+{
+    activeStatus = active;
+}
+
 QTime* JoyButtonSlot::getEasingTime()
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
@@ -554,6 +580,7 @@ void JoyButtonSlot::setTextData(QString textData)
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
     m_textData = textData;
+    compileTextEntryPlan();
 }
 
 QString JoyButtonSlot::getTextData()
@@ -564,6 +591,74 @@ QString JoyButtonSlot::getTextData()
     return m_textData;
 }
 
+/**
+ * @brief Get the keystrokes of a text entry slot resolved by the active event
+ *     handler. A published plan is never changed. When the keyboard mapping
+ *     changed since it was compiled, a new plan is compiled from the text
+ *     the old one was made for and published in its place.
+ * @return Compiled plan or a null pointer when the event handler cannot
+ *     precompile text
+ */
+QSharedPointer<const JoyButtonSlot::compiledTextEntry> JoyButtonSlot::getTextEntryPlan()
+{
+    textEntryPlanMutex.lock();
+    QSharedPointer<const compiledTextEntry> plan = textEntryPlan;
+    textEntryPlanMutex.unlock();
+
+    if (plan.isNull() || plan->text.isEmpty() || !EventHandlerFactory::hasInstance())
+        return QSharedPointer<const compiledTextEntry>();
+
+    if (plan->mappingGeneration != EventHandlerFactory::getInstance()->handler()->getKeyMappingGeneration())
+    {
+        QSharedPointer<const compiledTextEntry> updated = compileTextEntry(plan->text);
+
+        // Text changed in the meantime wins over the recompiled plan
+        textEntryPlanMutex.lock();
+        if (textEntryPlan == plan) textEntryPlan = updated;
+        textEntryPlanMutex.unlock();
+
+        plan = updated;
+    }
+
+    return plan->ready ? plan : QSharedPointer<const compiledTextEntry>();
+}
+
+/**
+ * @brief Resolve text entry data to keystrokes so pressing the button does
+ *     not have to walk the key mappers for every character. Compilation is
+ *     left to getTextEntryPlan when no event handler exists yet.
+ */
+void JoyButtonSlot::compileTextEntryPlan()
+{
+    QSharedPointer<const compiledTextEntry> plan;
+
+    if ((m_mode == JoyTextEntry) && !m_textData.isEmpty())
+        plan = compileTextEntry(m_textData);
+
+    QMutexLocker locker(&textEntryPlanMutex);
+    textEntryPlan = plan;
+}
+
+/**
+ * @brief Build a new plan for the given text with the active event handler.
+ */
+QSharedPointer<const JoyButtonSlot::compiledTextEntry> JoyButtonSlot::compileTextEntry(QString const& text)
+{
+    compiledTextEntry *plan = new compiledTextEntry();
+    plan->text = text;
+    plan->mappingGeneration = -1;
+    plan->ready = false;
+
+    if (EventHandlerFactory::hasInstance())
+    {
+        BaseEventHandler *handler = EventHandlerFactory::getInstance()->handler();
+        plan->mappingGeneration = handler->getKeyMappingGeneration();
+        plan->ready = handler->compileTextEntry(text, plan->strokes);
+    }
+
+    return QSharedPointer<const compiledTextEntry>(plan);
+}
+
 void JoyButtonSlot::setExtraData(QVariant data)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
@@ -679,5 +774,7 @@ JoyButtonSlot &JoyButtonSlot::operator=(JoyButtonSlot *slot)
     if (!slot->getTextData().isNull() ^ (slot->getTextData() != ""))
         this->m_textData = slot->getTextData();
 
+    compileTextEntryPlan();
+
     return *this;
 }
@@ -20,11 +20,16 @@
 #ifndef JOYBUTTONSLOT_H
 #define JOYBUTTONSLOT_H
 
+#include "eventhandlers/baseeventhandler.h"
+
 #include <QObject>
+#include <QVector>
 #include <QElapsedTimer>
 #include <QTime>
 #include <QVariant>
 #include <QPointer>
+#include <QSharedPointer>
+#include <QMutex>
 #include <QtWidgets/QApplication>
 
 class QXmlStreamReader;
@@ -45,6 +50,15 @@ public:
                                   MouseWheelLeft=6, MouseWheelRight=7};
     enum JoySlotMouseButton {MouseLB=1, MouseMB, MouseRB};
 
+    // Keystrokes of a text entry slot. Never changed once published.
+    typedef struct _compiledTextEntry
+    {
+        QString text;
+        QVector<textEntryStroke> strokes;
+        int mappingGeneration;
+        bool ready;
+    } compiledTextEntry;
+
     explicit JoyButtonSlot(QObject *parent = nullptr);
     explicit JoyButtonSlot(int code, JoySlotInputAction mode, QObject *parent=nullptr);
     explicit JoyButtonSlot(int code, int alias, JoySlotInputAction mode, QObject *parent=nullptr);
@@ -75,8 +89,12 @@ public:
     void setEasingStatus(bool isActive);
     QTime* getEasingTime();
 
+    bool isActive() const;
+    void setActiveStatus(bool active);
+
     void setTextData(QString textData);
     QString getTextData();
+    QSharedPointer<const compiledTextEntry> getTextEntryPlan();
 
     void setExtraData(QVariant data);
     QVariant getExtraData();
@@ -101,6 +119,8 @@ public:
 
 private:
     void secureMixSlotsInit();
+    void compileTextEntryPlan();
+    static QSharedPointer<const compiledTextEntry> compileTextEntry(QString const& text);
 
     int deviceCode;
     int qkeyaliasCode;
@@ -111,8 +131,12 @@ private:
     QElapsedTimer mouseInterval;
     QTime easingTime;
     bool easingActive;
+    bool activeStatus;
     QString m_textData;
     QVariant extraData;
+    // Swapped as a whole under the mutex. Readers keep their reference.
+    QSharedPointer<const compiledTextEntry> textEntryPlan;
+    QMutex textEntryPlanMutex;
     
 };
 
@@ -254,11 +254,11 @@ void JoyGradientButton::wheelEventVertical()
     {
         if (lastWheelVerticalDistance > 0.0)
         {
-            oldInterval = 1000 / wheelSpeedY / lastWheelVerticalDistance;
+            oldInterval = 1000 / (wheelSpeedY * getWheelStepsPerNotch()) / lastWheelVerticalDistance;
         }
         else
         {
-            oldInterval = 1000 / wheelSpeedY / 0.01;
+            oldInterval = 1000 / (wheelSpeedY * getWheelStepsPerNotch()) / 0.01;
         }
     }
 
@@ -284,7 +284,7 @@ void JoyGradientButton::wheelEventVertical()
 
             if (distance > 0.0)
             {
-                tempInterval = 1000 / wheelSpeedY / distance;
+                tempInterval = 1000 / (wheelSpeedY * getWheelStepsPerNotch()) / distance;
             }
             else
             {
@@ -313,18 +313,17 @@ void JoyGradientButton::wheelEventVertical()
 
     if ((buttonslot != nullptr) && (wheelSpeedY != 0))
     {
-        bool isActive = getActiveSlots().contains(buttonslot);
+        bool isActive = buttonslot->isActive();
 
         if (isActive && activateEvent)
         {
-            sendevent(buttonslot, true);
-            sendevent(buttonslot, false);
+            sendWheelStep(buttonslot);
             mouseWheelVerticalEventQueue.enqueue(buttonslot);
             double distance = getMouseDistanceFromDeadZone();
 
             if (distance > 0.0)
             {
-                tempInterval = 1000 / wheelSpeedY / distance;
+                tempInterval = 1000 / (wheelSpeedY * getWheelStepsPerNotch()) / distance;
             }
             else
             {
@@ -350,12 +349,11 @@ void JoyGradientButton::wheelEventVertical()
         while (!mouseWheelVerticalEventQueue.isEmpty())
         {
             buttonslot = mouseWheelVerticalEventQueue.dequeue();
-            bool isActive = getActiveSlots().contains(buttonslot);
+            bool isActive = buttonslot->isActive();
 
             if (isActive && activateEvent)
             {
-                sendevent(buttonslot, true);
-                sendevent(buttonslot, false);
+                sendWheelStep(buttonslot);
                 tempQueue.enqueue(buttonslot);
             }
             else if (isActive)
@@ -371,7 +369,7 @@ void JoyGradientButton::wheelEventVertical()
 
             if (distance > 0.0)
             {
-                tempInterval = 1000 / wheelSpeedY / distance;
+                tempInterval = 1000 / (wheelSpeedY * getWheelStepsPerNotch()) / distance;
             }
             else
             {
@@ -417,11 +415,11 @@ void JoyGradientButton::wheelEventHorizontal()
     {
         if (lastWheelHorizontalDistance > 0.0)
         {
-            oldInterval = 1000 / wheelSpeedX / lastWheelHorizontalDistance;
+            oldInterval = 1000 / (wheelSpeedX * getWheelStepsPerNotch()) / lastWheelHorizontalDistance;
         }
         else
         {
-            oldInterval = 1000 / wheelSpeedX / 0.01;
+            oldInterval = 1000 / (wheelSpeedX * getWheelStepsPerNotch()) / 0.01;
         }
     }
 
@@ -447,7 +445,7 @@ void JoyGradientButton::wheelEventHorizontal()
 
             if (distance > 0.0)
             {
-                tempInterval = 1000 / wheelSpeedX / distance;
+                tempInterval = 1000 / (wheelSpeedX * getWheelStepsPerNotch()) / distance;
             }
             else
             {
@@ -476,17 +474,16 @@ void JoyGradientButton::wheelEventHorizontal()
 
     if ((buttonslot != nullptr) && (wheelSpeedX != 0))
     {
-        bool isActive = getActiveSlots().contains(buttonslot);
+        bool isActive = buttonslot->isActive();
         if (isActive && activateEvent)
         {
-            sendevent(buttonslot, true);
-            sendevent(buttonslot, false);
+            sendWheelStep(buttonslot);
             mouseWheelHorizontalEventQueue.enqueue(buttonslot);
             double distance = getMouseDistanceFromDeadZone();
 
             if (distance > 0.0)
             {
-                tempInterval = 1000 / wheelSpeedX / distance;
+                tempInterval = 1000 / (wheelSpeedX * getWheelStepsPerNotch()) / distance;
             }
             else
             {
@@ -511,12 +508,11 @@ void JoyGradientButton::wheelEventHorizontal()
         while (!mouseWheelHorizontalEventQueue.isEmpty())
         {
             buttonslot = mouseWheelHorizontalEventQueue.dequeue();
-            bool isActive = getActiveSlots().contains(buttonslot);
+            bool isActive = buttonslot->isActive();
 
             if (isActive)
             {
-                sendevent(buttonslot, true);
-                sendevent(buttonslot, false);
+                sendWheelStep(buttonslot);
                 tempQueue.enqueue(buttonslot);
             }
         }
@@ -528,7 +524,7 @@ void JoyGradientButton::wheelEventHorizontal()
 
             if (distance > 0.0)
             {
-                tempInterval = 1000 / wheelSpeedX / distance;
+                tempInterval = 1000 / (wheelSpeedX * getWheelStepsPerNotch()) / distance;
             }
             else
             {
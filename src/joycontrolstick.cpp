@@ -25,6 +25,10 @@
 #include "xml/joybuttonxml.h"
 #include "joyaxis.h"
 
+#ifdef WITH_FIXED_POINT_STICK
+#include "stickfixedpoint.h"
+#endif
+
 #include <QDebug>
 #include <QHashIterator>
 #include <QStringList>
@@ -393,6 +397,9 @@ double JoyControlStick::calculateBearing(int axisXValue, int axisYValue)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
+#ifdef WITH_FIXED_POINT_STICK
+    return StickFixedPoint::toDouble(StickFixedPoint::bearing(axisXValue, axisYValue));
+#else
     double finalAngle = 0.0;
     int axis1Value = axisXValue;
     int axis2Value = axisYValue;
@@ -430,6 +437,7 @@ double JoyControlStick::calculateBearing(int axisXValue, int axisYValue)
     }
 
     return finalAngle;
+#endif
 }
 
 /**
@@ -456,6 +464,10 @@ double JoyControlStick::getDistanceFromDeadZone(int axisXValue, int axisYValue)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
+#ifdef WITH_FIXED_POINT_STICK
+    return StickFixedPoint::toDouble(StickFixedPoint::distanceFromDeadZone(axisXValue, axisYValue, deadZone,
+                                                                           maxZone, StickFixedPoint::fromDouble(circle)));
+#else
     double distance = 0.0;
 
     int axis1Value = axisXValue;
@@ -479,6 +491,7 @@ double JoyControlStick::getDistanceFromDeadZone(int axisXValue, int axisYValue)
     distance = (adjustedDist - adjustedDeadZone)/(static_cast<double>(maxZone) - adjustedDeadZone);
     distance = qBound(0.0, distance, 1.0);
     return distance;
+#endif
 }
 
 /**
@@ -508,6 +521,13 @@ double JoyControlStick::calculateYDistanceFromDeadZone(int axisXValue,
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
+#ifdef WITH_FIXED_POINT_STICK
+    // Interpolation along the diagonals stays in floating point
+    if (!interpolate || (diagonalRange >= 90))
+        return StickFixedPoint::toDouble(StickFixedPoint::axisDistanceFromDeadZone(-axisYValue, axisXValue, axisYValue, deadZone,
+                                                                                   maxZone, StickFixedPoint::fromDouble(circle)));
+#endif
+
     double distance = 0.0;
 
     int axis1Value = axisXValue;
@@ -650,6 +670,13 @@ double JoyControlStick::calculateXDistanceFromDeadZone(int axisXValue,
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
+#ifdef WITH_FIXED_POINT_STICK
+    // Interpolation along the diagonals stays in floating point
+    if (!interpolate || (diagonalRange >= 90))
+        return StickFixedPoint::toDouble(StickFixedPoint::axisDistanceFromDeadZone(axisXValue, axisXValue, axisYValue, deadZone,
+                                                                                   maxZone, StickFixedPoint::fromDouble(circle)));
+#endif
+
     double distance = 0.0;
 
     int axis1Value = axisXValue;
@@ -796,6 +823,9 @@ double JoyControlStick::getNormalizedAbsoluteDistance()
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
+#ifdef WITH_FIXED_POINT_STICK
+    return getRadialDistance(axisX->getCurrentRawValue(), axisY->getCurrentRawValue());
+#else
     int axis1Value = axisX->getCurrentRawValue();
     int axis2Value = axisY->getCurrentRawValue();
 
@@ -808,12 +838,16 @@ double JoyControlStick::getNormalizedAbsoluteDistance()
     else if (distance < 0.0) distance = 0.0;
 
     return distance;
+#endif
 }
 
 double JoyControlStick::getRadialDistance(int axisXValue, int axisYValue)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
+#ifdef WITH_FIXED_POINT_STICK
+    return StickFixedPoint::toDouble(StickFixedPoint::radialDistance(axisXValue, axisYValue, maxZone));
+#else
     int axis1Value = axisXValue;
     int axis2Value = axisYValue;
 
@@ -826,6 +860,7 @@ double JoyControlStick::getRadialDistance(int axisXValue, int axisYValue)
     else if (distance < 0.0) distance = 0.0;
 
     return distance;
+#endif
 }
 
 void JoyControlStick::setIndex(int index)
@@ -3277,6 +3312,9 @@ void JoyControlStick::queueJoyEvent(bool ignoresets)
 
     Q_UNUSED(ignoresets)
 
+    if (!pendingStickEvent && (getParentSet() != nullptr))
+        getParentSet()->addPendingElement(this);
+
     pendingStickEvent = true;
 }
 
@@ -166,6 +166,9 @@ void JoyDPad::queuePendingEvent(int value, bool ignoresets)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
+    if (!pendingEvent && (m_parentSet != nullptr))
+        m_parentSet->addPendingElement(this);
+
     pendingEvent = true;
     pendingEventDirection = value;
     pendingIgnoreSets = ignoresets;
@@ -1344,3 +1347,32 @@ void JoyDPad::eventReset()
         button->eventReset();
     }
 }
+
+/**
+ * @brief Return the dpad and its buttons to the default settings without
+ *     recreating them. Used when a profile is reloaded partially.
+ */
+void JoyDPad::reset()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    directionDelayTimer.stop();
+
+    QHashIterator<int, JoyDPadButton*> iter(buttons);
+    while (iter.hasNext())
+    {
+        JoyDPadButton *button = iter.next().value();
+        button->reset();
+    }
+
+    activeDiagonalButton = nullptr;
+    prevDirection = JoyDPadButton::DpadCentered;
+    pendingDirection = prevDirection;
+    currentMode = StandardMode;
+    dpadDelay = GlobalVariables::JoyDPad::DEFAULTDPADDELAY;
+    dpadName.clear();
+
+    pendingEvent = false;
+    pendingEventDirection = prevDirection;
+    pendingIgnoreSets = false;
+}
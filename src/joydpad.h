@@ -107,6 +107,7 @@ public:
     void copyLastDistanceValues(JoyDPad *srcDPad);
 
     virtual void eventReset(); // JoyDPadEvent class
+    void reset();
 
 signals:
     void active(int value);
@@ -78,6 +78,16 @@ JoyTabWidget::JoyTabWidget(InputDevice *joystick, AntiMicroSettings *settings, Q
     m_settings = settings;
 
     tabHelper.moveToThread(joystick->thread());
+    connect(&tabHelper, &JoyTabWidgetHelper::configFileWriteFailed, this, &JoyTabWidget::showProfileWriteError);
+    connect(&tabHelper, &JoyTabWidgetHelper::configFileWriteFinished, this, &JoyTabWidget::finishProfileSave);
+
+    profileReloadTimer.setSingleShot(true);
+    profileReloadTimer.setInterval(PROFILERELOADDELAY);
+    connect(&profileReloadTimer, &QTimer::timeout, this, &JoyTabWidget::reloadWatchedProfile);
+    connect(&profileWatcher, &QFileSystemWatcher::fileChanged, [this](const QString &path) {
+        Q_UNUSED(path);
+        profileReloadTimer.start();
+    });
 
     comboBoxIndex = 0;
     hideEmptyButtons = false;
@@ -635,7 +645,6 @@ void JoyTabWidget::saveConfigFile()
 
     m_settings->getLock()->lock();
 
-    int numberRecentProfiles = m_settings->value("NumberRecentProfiles", DEFAULTNUMBERPROFILES).toInt();
     QString filename = QString();
     if (index == 0)
     {
@@ -665,69 +674,15 @@ void JoyTabWidget::saveConfigFile()
     {
         QFileInfo fileinfo(filename);
 
+        // The profile as written is the one in use now. Edits made while
+        // the file is written mark it as edited again.
+        m_joystick->revertProfileEdited();
+
+        // Recent profiles and the last selected profile are updated by
+        // finishProfileSave once the file was written
+        pendingProfileSave = fileinfo.absoluteFilePath();
         QMetaObject::invokeMethod(&tabHelper, "writeConfigFile", Qt::BlockingQueuedConnection,
                                   Q_ARG(QString, fileinfo.absoluteFilePath()));
-        XMLConfigWriter *writer = tabHelper.getWriter();
-
-        if (writer->hasError() && this->window()->isEnabled())
-        {
-            QMessageBox msg;
-            msg.setStandardButtons(QMessageBox::Close);
-            msg.setText(writer->getErrorString());
-            msg.setModal(true);
-            msg.exec();
-        }
-        else if (writer->hasError() && !this->window()->isEnabled())
-        {
-            QTextStream error(stderr);
-            error << writer->getErrorString() << endl;
-        }
-        else
-        {
-            int existingIndex = configBox->findData(fileinfo.absoluteFilePath());
-
-            if (existingIndex == -1)
-            {
-                if ((numberRecentProfiles > 0) && (configBox->count() == (numberRecentProfiles + 1)))
-                {
-                    configBox->removeItem(numberRecentProfiles);
-                }
-
-                m_joystick->revertProfileEdited();
-                QString tempProfileName = PadderCommon::getProfileName(fileinfo);
-                if (!m_joystick->getProfileName().isEmpty())
-                {
-                    oldProfileName = m_joystick->getProfileName();
-                    tempProfileName = oldProfileName;
-                }
-
-                disconnectCheckUnsavedEvent();
-                disconnectMainComboBoxEvents();
-
-                configBox->insertItem(1, tempProfileName, fileinfo.absoluteFilePath());
-
-                reconnectCheckUnsavedEvent();
-                reconnectMainComboBoxEvents();
-
-                configBox->setCurrentIndex(1);
-                saveDeviceSettings(true);
-
-                emit joystickConfigChanged(m_joystick->getJoyNumber());
-            }
-            else
-            {
-                m_joystick->revertProfileEdited();
-                if (!m_joystick->getProfileName().isEmpty())
-                {
-                    oldProfileName = m_joystick->getProfileName();
-                }
-
-                configBox->setItemIcon(existingIndex, QIcon());
-                saveDeviceSettings(true);
-
-                emit joystickConfigChanged(m_joystick->getJoyNumber());
-            }
-        }
     }
 }
 
@@ -816,7 +771,6 @@ void JoyTabWidget::saveAsConfig()
 
     m_settings->getLock()->lock();
 
-    int numberRecentProfiles = m_settings->value("NumberRecentProfiles", DEFAULTNUMBERPROFILES).toInt();
     QString filename = QString();
     if (index == 0)
     {
@@ -853,66 +807,15 @@ void JoyTabWidget::saveAsConfig()
         }
         fileinfo.setFile(filename);
 
+        // The profile as written is the one in use now. Edits made while
+        // the file is written mark it as edited again.
+        m_joystick->revertProfileEdited();
+
+        // Recent profiles and the last selected profile are updated by
+        // finishProfileSave once the file was written
+        pendingProfileSave = fileinfo.absoluteFilePath();
         QMetaObject::invokeMethod(&tabHelper, "writeConfigFile", Qt::BlockingQueuedConnection,
                                   Q_ARG(QString, fileinfo.absoluteFilePath()));
-        XMLConfigWriter *writer = tabHelper.getWriter();
-
-        if (writer->hasError() && this->window()->isEnabled())
-        {
-            QMessageBox msg;
-            msg.setStandardButtons(QMessageBox::Close);
-            msg.setText(writer->getErrorString());
-            msg.setModal(true);
-            msg.exec();
-        }
-        else if (writer->hasError() && !this->window()->isEnabled())
-        {
-            QTextStream error(stderr);
-            error << writer->getErrorString() << endl;
-        }
-        else
-        {
-            int existingIndex = configBox->findData(fileinfo.absoluteFilePath());
-            if (existingIndex == -1)
-            {
-                disconnectCheckUnsavedEvent();
-                disconnectMainComboBoxEvents();
-
-                if ((numberRecentProfiles > 0) && (configBox->count() == (numberRecentProfiles + 1)))
-                {
-                    configBox->removeItem(numberRecentProfiles);
-                }
-
-                m_joystick->revertProfileEdited();
-                QString tempProfileName = PadderCommon::getProfileName(fileinfo);
-                if (!m_joystick->getProfileName().isEmpty())
-                {
-                    oldProfileName = m_joystick->getProfileName();
-                    tempProfileName = oldProfileName;
-                }
-
-                configBox->insertItem(1, tempProfileName, fileinfo.absoluteFilePath());
-
-                reconnectCheckUnsavedEvent();
-                reconnectMainComboBoxEvents();
-
-                configBox->setCurrentIndex(1);
-                saveDeviceSettings(true);
-                emit joystickConfigChanged(m_joystick->getJoyNumber());
-            }
-            else
-            {
-                m_joystick->revertProfileEdited();
-                if (!m_joystick->getProfileName().isEmpty())
-                {
-                    oldProfileName = m_joystick->getProfileName();
-                }
-
-                configBox->setItemIcon(existingIndex, QIcon());
-                saveDeviceSettings(true);
-                emit joystickConfigChanged(m_joystick->getJoyNumber());
-            }
-        }
     }
 }
 
@@ -938,11 +841,11 @@ void JoyTabWidget::changeJoyConfig(int index)
         if (SDL_JoystickCurrentPowerLevel(m_joystick->getJoyHandle()) == SDL_JOYSTICK_POWER_WIRED ||
             SDL_JoystickCurrentPowerLevel(m_joystick->getJoyHandle()) == SDL_JOYSTICK_POWER_UNKNOWN)
         {
-            QMetaObject::invokeMethod(&tabHelper, "readConfigFile", Qt::BlockingQueuedConnection, Q_ARG(QString, filename));
+            QMetaObject::invokeMethod(&tabHelper, "reloadConfigFile", Qt::BlockingQueuedConnection, Q_ARG(QString, filename));
         }
         else
         {
-            tabHelper.readConfigFile(filename);
+            tabHelper.reloadConfigFile(filename);
         }
 
         fillButtons();
@@ -996,6 +899,7 @@ void JoyTabWidget::changeJoyConfig(int index)
     }
 
     comboBoxIndex = index;
+    watchProfile(filename);
 
     connect(m_joystick, &InputDevice::profileUpdated, this, &JoyTabWidget::displayProfileEditNotification);
 }
@@ -1097,7 +1001,9 @@ void JoyTabWidget::loadSettings(bool forceRefresh)
 
     disconnect(configBox, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged), this, &JoyTabWidget::changeJoyConfig);
 
-    m_settings->getLock()->lock();
+    // Read from a snapshot so that the settings lock is not held while the
+    // profile list is rebuilt.
+    QSharedPointer<const AntiMicroSettings::settingsSnapshot> values = m_settings->snapshot();
 
     if (configBox->count() > 1)
     {
@@ -1111,22 +1017,21 @@ void JoyTabWidget::loadSettings(bool forceRefresh)
     }
 
 
-    int shouldisplaynames = m_settings->value("DisplayNames", "0").toInt();
+    int shouldisplaynames = values->value("DisplayNames", "0").toInt();
     if (shouldisplaynames == 1)
     {
         changeNameDisplay(shouldisplaynames);
     }
 
-    int numberRecentProfiles = m_settings->value("NumberRecentProfiles", DEFAULTNUMBERPROFILES).toInt();
-    bool autoOpenLastProfile = m_settings->value("AutoOpenLastProfile", true).toBool();
+    int numberRecentProfiles = values->value("NumberRecentProfiles", DEFAULTNUMBERPROFILES).toInt();
+    bool autoOpenLastProfile = values->value("AutoOpenLastProfile", true).toBool();
 
-    m_settings->beginGroup("Controllers");
-
-    convToUniqueIDControllerGroupSett(m_settings, QString("Controller%1LastSelected").arg(m_joystick->getGUIDString()), QString("Controller%1LastSelected").arg(m_joystick->getUniqueIDString()));
+    if (m_settings->moveDeferred(QString("Controllers/Controller%1LastSelected").arg(m_joystick->getGUIDString()), QString("Controllers/Controller%1LastSelected").arg(m_joystick->getUniqueIDString())))
+        values = m_settings->snapshot();
 
-    QString controlEntryString = QString("Controller%1ConfigFile%2").arg(m_joystick->getStringIdentifier());
-    QString controlEntryLastSelected = QString("Controller%1LastSelected").arg(m_joystick->getStringIdentifier());
-    QString controlEntryProfileName = QString("Controller%1ProfileName%2").arg(m_joystick->getStringIdentifier());
+    QString controlEntryString = QString("Controllers/Controller%1ConfigFile%2").arg(m_joystick->getStringIdentifier());
+    QString controlEntryLastSelected = QString("Controllers/Controller%1LastSelected").arg(m_joystick->getStringIdentifier());
+    QString controlEntryProfileName = QString("Controllers/Controller%1ProfileName%2").arg(m_joystick->getStringIdentifier());
 
 
     bool finished = false;
@@ -1136,8 +1041,10 @@ void JoyTabWidget::loadSettings(bool forceRefresh)
 
         if (!m_joystick->getStringIdentifier().isEmpty())
         {
-            convToUniqueIDControllerGroupSett(m_settings, QString("Controller%1ConfigFile%2").arg(m_joystick->getGUIDString()).arg(i), QString("Controller%1ConfigFile%2").arg(m_joystick->getUniqueIDString()).arg(i));
-            tempfilepath = m_settings->value(controlEntryString.arg(i), "").toString();
+            if (m_settings->moveDeferred(QString("Controllers/Controller%1ConfigFile%2").arg(m_joystick->getGUIDString()).arg(i), QString("Controllers/Controller%1ConfigFile%2").arg(m_joystick->getUniqueIDString()).arg(i)))
+                values = m_settings->snapshot();
+
+            tempfilepath = values->value(controlEntryString.arg(i), "").toString();
         }
 
         if (!tempfilepath.isEmpty())
@@ -1146,8 +1053,10 @@ void JoyTabWidget::loadSettings(bool forceRefresh)
 
             if (fileInfo.exists() && (configBox->findData(fileInfo.absoluteFilePath()) == -1))
             {
-                convToUniqueIDControllerGroupSett(m_settings, QString("Controller%1ProfileName%2").arg(m_joystick->getGUIDString()).arg(i), QString("Controller%1ProfileName%2").arg(m_joystick->getUniqueIDString()).arg(i));
-                QString profileName = m_settings->value(controlEntryProfileName.arg(i), "").toString();
+                if (m_settings->moveDeferred(QString("Controllers/Controller%1ProfileName%2").arg(m_joystick->getGUIDString()).arg(i), QString("Controllers/Controller%1ProfileName%2").arg(m_joystick->getUniqueIDString()).arg(i)))
+                    values = m_settings->snapshot();
+
+                QString profileName = values->value(controlEntryProfileName.arg(i), "").toString();
                 profileName = !profileName.isEmpty() ? profileName : PadderCommon::getProfileName(fileInfo);
                 configBox->addItem(profileName, fileInfo.absoluteFilePath());
             }
@@ -1169,13 +1078,9 @@ void JoyTabWidget::loadSettings(bool forceRefresh)
 
     if (!m_joystick->getStringIdentifier().isEmpty() && autoOpenLastProfile)
     {
-        lastfile = m_settings->value(controlEntryLastSelected, "").toString();
+        lastfile = values->value(controlEntryLastSelected, "").toString();
     }
 
-    m_settings->endGroup();
-    m_settings->getLock()->unlock();
-
-
     if (!lastfile.isEmpty())
     {
         QString lastFileAbsolute = lastfile;
@@ -1246,6 +1151,13 @@ QString JoyTabWidget::getConfigName(int index)
     return configBox->itemText(index);
 }
 
+QString JoyTabWidget::getCurrentConfigFile()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    return configBox->itemData(configBox->currentIndex()).toString();
+}
+
 void JoyTabWidget::changeCurrentSet(int index)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
@@ -1399,6 +1311,12 @@ void JoyTabWidget::loadConfigFile(QString fileLocation)
                 configBox->setCurrentIndex(searchIndex);
                 emit joystickConfigChanged(m_joystick->getJoyNumber());
             }
+            else
+            {
+                // Profile already in use, e.g. given again after editing it
+                // outside of the program. Only changed elements are reset.
+                changeJoyConfig(searchIndex);
+            }
         }
     }
 }
@@ -1486,6 +1404,8 @@ void JoyTabWidget::saveDeviceSettings(bool sync)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
+    m_settings->flushPendingWrites();
+
     m_settings->getLock()->lock();
     m_settings->beginGroup("Controllers");
     m_settings->getLock()->unlock();
@@ -1498,6 +1418,8 @@ void JoyTabWidget::saveDeviceSettings(bool sync)
     if (sync) m_settings->sync();
 
     m_settings->getLock()->unlock();
+
+    m_settings->refreshSnapshot();
 }
 
 void JoyTabWidget::loadDeviceSettings()
@@ -1602,6 +1524,200 @@ void JoyTabWidget::displayProfileEditNotification()
     changedNotSaved = true;
 }
 
+/**
+ * @brief Watch the profile in use for changes made by other programs if
+ *     the user enabled it. Only one profile per device is watched.
+ * @param Profile in use or an empty string for none
+ */
+void JoyTabWidget::watchProfile(QString filename)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    profileReloadTimer.stop();
+
+    if (!profileWatcher.files().isEmpty())
+        profileWatcher.removePaths(profileWatcher.files());
+
+    bool autoReloadProfiles = m_settings->snapshotValue("AutoReloadProfiles", false).toBool();
+
+    if (autoReloadProfiles && !filename.isEmpty())
+        profileWatcher.addPath(filename);
+}
+
+/**
+ * @brief Watch the profile in use again or stop watching it after the
+ *     profile reloading option was changed.
+ */
+void JoyTabWidget::refreshProfileWatch()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    int index = configBox->currentIndex();
+    watchProfile((index > 0) ? configBox->itemData(index).toString() : QString());
+}
+
+/**
+ * @brief Load the watched profile again after it was changed on disk.
+ *     Only elements that changed are re-initialised.
+ */
+void JoyTabWidget::reloadWatchedProfile()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    int index = configBox->currentIndex();
+    QString filename = (index > 0) ? configBox->itemData(index).toString() : QString();
+
+    // The option could have been turned off after the change was noticed
+    if (!m_settings->snapshotValue("AutoReloadProfiles", false).toBool())
+    {
+        watchProfile(QString());
+        return;
+    }
+
+    if (filename.isEmpty() || !QFileInfo::exists(filename))
+        return;
+
+    // Replacing a file by renaming another one over it drops it from
+    // the watcher
+    if (!profileWatcher.files().contains(filename))
+        profileWatcher.addPath(filename);
+
+    // Keep changes made in the program that are not saved yet
+    if (m_joystick->isDeviceEdited())
+        return;
+
+    // Saving the profile in the program triggers the watcher as well
+    bool differs = true;
+    QMetaObject::invokeMethod(&tabHelper, "configFileDiffers", Qt::BlockingQueuedConnection,
+                              Q_RETURN_ARG(bool, differs), Q_ARG(QString, filename));
+
+    if (!differs)
+        return;
+
+    qDebug() << "Reloading changed profile" << filename;
+
+    changeJoyConfig(index);
+}
+
+/**
+ * @brief Finish saving a profile once its file was written. The profile
+ *     becomes the selected and most recent one. A failed write leaves the
+ *     recent profiles and the settings alone and marks the profile as
+ *     edited again.
+ * @param Profile that was written
+ * @param Whether the file was written
+ */
+void JoyTabWidget::finishProfileSave(QString filename, bool success)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    // Already finished by finishPendingProfileSave or replaced by a save
+    // to another file
+    if (filename != pendingProfileSave)
+        return;
+
+    pendingProfileSave.clear();
+
+    if (!success)
+    {
+        m_joystick->profileEdited();
+        return;
+    }
+
+    QFileInfo fileinfo(filename);
+
+    m_settings->getLock()->lock();
+    int numberRecentProfiles = m_settings->value("NumberRecentProfiles", DEFAULTNUMBERPROFILES).toInt();
+    m_settings->getLock()->unlock();
+
+    int existingIndex = configBox->findData(fileinfo.absoluteFilePath());
+
+    if (existingIndex == -1)
+    {
+        disconnectCheckUnsavedEvent();
+        disconnectMainComboBoxEvents();
+
+        if ((numberRecentProfiles > 0) && (configBox->count() == (numberRecentProfiles + 1)))
+        {
+            configBox->removeItem(numberRecentProfiles);
+        }
+
+        QString tempProfileName = PadderCommon::getProfileName(fileinfo);
+        if (!m_joystick->getProfileName().isEmpty())
+        {
+            oldProfileName = m_joystick->getProfileName();
+            tempProfileName = oldProfileName;
+        }
+
+        configBox->insertItem(1, tempProfileName, fileinfo.absoluteFilePath());
+
+        reconnectCheckUnsavedEvent();
+        reconnectMainComboBoxEvents();
+
+        configBox->setCurrentIndex(1);
+        saveDeviceSettings(true);
+        emit joystickConfigChanged(m_joystick->getJoyNumber());
+    }
+    else
+    {
+        if (!m_joystick->getProfileName().isEmpty())
+        {
+            oldProfileName = m_joystick->getProfileName();
+        }
+
+        if (!m_joystick->isDeviceEdited())
+            configBox->setItemIcon(existingIndex, QIcon());
+
+        saveDeviceSettings(true);
+        emit joystickConfigChanged(m_joystick->getJoyNumber());
+    }
+}
+
+/**
+ * @brief Wait for the profile written by saveConfigFile and finish saving
+ *     it right away, for callers that depend on the outcome.
+ */
+void JoyTabWidget::finishPendingProfileSave()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    if (pendingProfileSave.isEmpty())
+        return;
+
+    bool success = false;
+    QMetaObject::invokeMethod(&tabHelper, "waitForConfigFileWrite", Qt::BlockingQueuedConnection,
+                              Q_RETURN_ARG(bool, success));
+
+    finishProfileSave(pendingProfileSave, success);
+}
+
+/**
+ * @brief Report a profile that could not be written in the background.
+ *     The profile is flagged as edited again since the changes were not
+ *     saved.
+ * @param Error message of the writer
+ */
+void JoyTabWidget::showProfileWriteError(QString errorString)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    displayProfileEditNotification();
+
+    if (this->window()->isEnabled())
+    {
+        QMessageBox msg;
+        msg.setStandardButtons(QMessageBox::Close);
+        msg.setText(errorString);
+        msg.setModal(true);
+        msg.exec();
+    }
+    else
+    {
+        QTextStream error(stderr);
+        error << errorString << endl;
+    }
+}
+
 void JoyTabWidget::removeProfileEditNotification()
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
@@ -1697,6 +1813,7 @@ void JoyTabWidget::checkForUnsavedProfile(int newindex)
             case QMessageBox::Save:
             {
                 saveConfigFile();
+                finishPendingProfileSave();
                 reconnectCheckUnsavedEvent();
                 reconnectMainComboBoxEvents();
 
@@ -1767,6 +1884,8 @@ bool JoyTabWidget::discardUnsavedProfileChanges()
             case QMessageBox::Save:
             {
                 saveConfigFile();
+                finishPendingProfileSave();
+
                 if ((currentIndex == 0) && (currentIndex == configBox->currentIndex()))
                 {
                     discarded = false;
@@ -2618,11 +2737,17 @@ void JoyTabWidget::changeEvent(QEvent *event)
     QWidget::changeEvent(event);
 }
 
-void JoyTabWidget::convToUniqueIDControllerGroupSett(QSettings* sett, QString guidControllerSett, QString uniqueControllerSett)
+/**
+ * @brief Move a setting stored under the GUID of a controller by older
+ *     versions to the unique ID of the controller. The snapshot changes
+ *     right away, the settings file with the next deferred write.
+ * @param Settings holding the value
+ * @param Full key using the GUID
+ * @param Full key using the unique ID
+ */
+void JoyTabWidget::convToUniqueIDControllerGroupSett(AntiMicroSettings* sett, QString guidControllerSett, QString uniqueControllerSett)
 {
-    if (sett->contains(guidControllerSett))
-    {
-        sett->setValue(uniqueControllerSett, sett->value(guidControllerSett));
-        sett->remove(guidControllerSett);
-    }
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    sett->moveDeferred(guidControllerSett, uniqueControllerSett);
 }
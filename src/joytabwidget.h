@@ -21,6 +21,8 @@
 #define JOYTABWIDGET_H
 
 #include <QWidget>
+#include <QFileSystemWatcher>
+#include <QTimer>
 
 #include "uihelpers/joytabwidgethelper.h"
 
@@ -48,13 +50,18 @@ class JoyTabWidget : public QWidget
 public:
     explicit JoyTabWidget(InputDevice *joystick, AntiMicroSettings *settings, QWidget *parent = nullptr);
 
+    // Wait after the last change of a watched profile before reloading it,
+    // so a file written in several steps is read once.
+    static const int PROFILERELOADDELAY = 500;
+
     void saveSettings(); // JoyTabSettings class
     void loadSettings(bool forceRefresh=false); // JoyTabSettings class
     void setCurrentConfig(int index); // JoyTabSettings class
     void unloadConfig(); // JoyTabSettings class
     void checkHideEmptyOption();
+    void refreshProfileWatch();
     void refreshHelperThread();
-    void convToUniqueIDControllerGroupSett(QSettings* sett, QString guidControllerSett, QString uniqueControllerSett);
+    void convToUniqueIDControllerGroupSett(AntiMicroSettings* sett, QString guidControllerSett, QString uniqueControllerSett);
 
     bool isDisplayingNames();
     bool discardUnsavedProfileChanges();
@@ -66,6 +73,7 @@ public:
 
     QString getCurrentConfigName(); // JoyTabSettings class
     QString getConfigName(int index);
+    QString getCurrentConfigFile(); // JoyTabSettings class
 
     InputDevice *getJoystick();
 
@@ -125,6 +133,8 @@ private slots:
     void changeSetEight(); // JoyTabWidgetSets class
     void displayProfileEditNotification();
     void removeProfileEditNotification();
+    void showProfileWriteError(QString errorString);
+    void finishProfileSave(QString filename, bool success);
     void checkForUnsavedProfile(int newindex=-1);
 
     void checkStickDisplay();
@@ -143,8 +153,12 @@ private slots:
     void refreshSetButtons(); // JoyTabWidgetSets class
     void openGameControllerMappingWindow();
     void propogateMappingUpdate(QString mapping, InputDevice *device);
+    void reloadWatchedProfile();
 
 private:
+    void watchProfile(QString filename);
+    void finishPendingProfileSave();
+
     QVBoxLayout *verticalLayout;
     QHBoxLayout *configHorizontalLayout;
     QPushButton *removeButton;
@@ -214,8 +228,11 @@ private:
     int comboBoxIndex;
     bool hideEmptyButtons;
     QString oldProfileName;
+    QString pendingProfileSave;
 
     JoyTabWidgetHelper tabHelper;
+    QFileSystemWatcher profileWatcher;
+    QTimer profileReloadTimer;
 
 };
 
@@ -80,6 +80,8 @@ void LocalAntiMicroServer::handleOutsideConnection()
         if (socket != nullptr)
         {
             qDebug() << "There is next pending connection: " << socket->socketDescriptor() << endl;
+            socketBuffers.insert(socket, QByteArray());
+            connect(socket, &QLocalSocket::readyRead, this, &LocalAntiMicroServer::handleSocketData);
             connect(socket, &QLocalSocket::disconnected, this, &LocalAntiMicroServer::handleSocketDisconnect);
             connect(socket, &QLocalSocket::disconnected, socket, &QLocalSocket::deleteLater);
         }
@@ -98,7 +100,69 @@ void LocalAntiMicroServer::handleSocketDisconnect()
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
-    emit clientdisconnect();
+    QLocalSocket *socket = qobject_cast<QLocalSocket*>(sender());
+    bool sentCommands = commandSockets.contains(socket);
+
+    socketBuffers.remove(socket);
+    commandSockets.remove(socket);
+
+    // Older clients save their changes to the settings file and only
+    // disconnect. Clients speaking the command protocol have already been
+    // served so the settings must not be reloaded over their changes.
+    if (!sentCommands) emit clientdisconnect();
+}
+
+void LocalAntiMicroServer::handleSocketData()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    QLocalSocket *socket = qobject_cast<QLocalSocket*>(sender());
+
+    if ((socket == nullptr) || !socketBuffers.contains(socket)) return;
+
+    QByteArray &buffer = socketBuffers[socket];
+    buffer.append(socket->readAll());
+
+    LocalServerMessage message;
+    bool malformed = false;
+
+    while (LocalServerMessage::takeFrame(buffer, message, malformed))
+    {
+        commandSockets.insert(socket);
+
+        if (message.getType() == LocalServerMessage::Reply)
+        {
+            sendReply(socket, LocalServerMessage::reply(LocalServerMessage::StatusUnknownCommand,
+                                                        tr("Unexpected reply message")));
+        }
+        else
+        {
+            emit commandReceived(socket, message);
+        }
+
+        // Handlers may have closed the connection.
+        if (!socketBuffers.contains(socket)) return;
+    }
+
+    if (malformed)
+    {
+        qDebug() << "Dropping client sending malformed data: " << socket->socketDescriptor() << endl;
+        commandSockets.insert(socket);
+        buffer.clear();
+        socket->abort();
+    }
+}
+
+void LocalAntiMicroServer::sendReply(QLocalSocket *socket, LocalServerMessage message)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    if ((socket != nullptr) && socketBuffers.contains(socket) &&
+        (socket->state() == QLocalSocket::ConnectedState))
+    {
+        socket->write(message.toFrame());
+        socket->flush();
+    }
 }
 
 void LocalAntiMicroServer::close()
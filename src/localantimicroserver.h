@@ -20,10 +20,16 @@
 #ifndef LOCALANTIMICROSERVER_H
 #define LOCALANTIMICROSERVER_H
 
+#include "localservermessage.h"
+
 #include <QObject>
+#include <QHash>
+#include <QSet>
+#include <QByteArray>
 
 
 class QLocalServer;
+class QLocalSocket;
 
 class LocalAntiMicroServer : public QObject
 {
@@ -37,15 +43,22 @@ public:
 
 signals:
     void clientdisconnect();
+    void commandReceived(QLocalSocket *socket, LocalServerMessage message);
 
 public slots:
     void startLocalServer();
     void handleOutsideConnection();
     void handleSocketDisconnect();
+    void handleSocketData();
+    void sendReply(QLocalSocket *socket, LocalServerMessage message);
     void close();
 
 private:
     QLocalServer *localServer;
+    // Pending bytes of every connected client. Clients that never sent a
+    // command keep an empty entry and get the old reload on disconnect.
+    QHash<QLocalSocket*, QByteArray> socketBuffers;
+    QSet<QLocalSocket*> commandSockets;
 
 };
 
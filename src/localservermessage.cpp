@@ -0,0 +1,156 @@
+/* antimicroX Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ * Copyright (C) 2020 Jagoda Górska <juliagoda.pl@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "localservermessage.h"
+
+#include <QDataStream>
+#include <QtEndian>
+
+
+LocalServerMessage::LocalServerMessage(MessageType type) :
+    type(type),
+    controllerNumber(0),
+    setNumber(0),
+    status(StatusOk)
+{
+}
+
+LocalServerMessage LocalServerMessage::reply(ReplyStatus status, QString text)
+{
+    LocalServerMessage message(Reply);
+    message.status = status;
+    message.text = text;
+
+    return message;
+}
+
+LocalServerMessage::MessageType LocalServerMessage::getType() const
+{
+    return type;
+}
+
+void LocalServerMessage::setProfileLocation(QString location)
+{
+    profileLocation = location;
+}
+
+QString const& LocalServerMessage::getProfileLocation() const
+{
+    return profileLocation;
+}
+
+void LocalServerMessage::setControllerNumber(int number)
+{
+    controllerNumber = number;
+}
+
+int LocalServerMessage::getControllerNumber() const
+{
+    return controllerNumber;
+}
+
+void LocalServerMessage::setControllerID(QString controllerID)
+{
+    this->controllerID = controllerID;
+}
+
+QString const& LocalServerMessage::getControllerID() const
+{
+    return controllerID;
+}
+
+void LocalServerMessage::setSetNumber(int number)
+{
+    setNumber = number;
+}
+
+int LocalServerMessage::getSetNumber() const
+{
+    return setNumber;
+}
+
+LocalServerMessage::ReplyStatus LocalServerMessage::getStatus() const
+{
+    return status;
+}
+
+QString const& LocalServerMessage::getText() const
+{
+    return text;
+}
+
+QByteArray LocalServerMessage::toFrame() const
+{
+    QByteArray payload;
+    QDataStream stream(&payload, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_0);
+    stream << static_cast<quint8>(type) << profileLocation << static_cast<qint32>(controllerNumber)
+           << controllerID << static_cast<qint32>(setNumber) << static_cast<quint8>(status) << text;
+
+    QByteArray frame(sizeof(quint32), Qt::Uninitialized);
+    qToBigEndian<quint32>(static_cast<quint32>(payload.size()), reinterpret_cast<uchar*>(frame.data()));
+    frame.append(payload);
+
+    return frame;
+}
+
+bool LocalServerMessage::takeFrame(QByteArray &buffer, LocalServerMessage &message, bool &malformed)
+{
+    malformed = false;
+
+    if (buffer.size() < static_cast<int>(sizeof(quint32))) return false;
+
+    quint32 length = qFromBigEndian<quint32>(reinterpret_cast<const uchar*>(buffer.constData()));
+
+    if (length > MAXFRAMESIZE)
+    {
+        malformed = true;
+        return false;
+    }
+
+    if (static_cast<quint32>(buffer.size()) - sizeof(quint32) < length) return false;
+
+    QByteArray payload = buffer.mid(sizeof(quint32), static_cast<int>(length));
+    buffer.remove(0, static_cast<int>(sizeof(quint32) + length));
+
+    QDataStream stream(payload);
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    quint8 tempType = 0;
+    qint32 tempControllerNumber = 0;
+    qint32 tempSetNumber = 0;
+    quint8 tempStatus = 0;
+    LocalServerMessage temp;
+    stream >> tempType >> temp.profileLocation >> tempControllerNumber
+           >> temp.controllerID >> tempSetNumber >> tempStatus >> temp.text;
+
+    if ((stream.status() != QDataStream::Ok) || (tempType > QueryStats) || (tempStatus > StatusUnknownCommand))
+    {
+        malformed = true;
+        return false;
+    }
+
+    temp.type = static_cast<MessageType>(tempType);
+    temp.controllerNumber = tempControllerNumber;
+    temp.setNumber = tempSetNumber;
+    temp.status = static_cast<ReplyStatus>(tempStatus);
+    message = temp;
+
+    return true;
+}
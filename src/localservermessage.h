@@ -0,0 +1,98 @@
+/* antimicroX Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ * Copyright (C) 2020 Jagoda Górska <juliagoda.pl@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LOCALSERVERMESSAGE_H
+#define LOCALSERVERMESSAGE_H
+
+#include <QString>
+#include <QByteArray>
+
+
+/**
+ * @brief Single request or reply exchanged with a running instance over
+ *     the local socket. Every frame is a big endian quint32 payload length
+ *     followed by a QDataStream encoded payload.
+ */
+class LocalServerMessage
+{
+public:
+    enum MessageType {
+        Reply = 0,
+        LoadProfile,
+        UnloadProfile,
+        ChangeSet,
+        ListControllers,
+        QueryStats
+    };
+
+    enum ReplyStatus {
+        StatusOk = 0,
+        StatusFailed,
+        StatusUnknownCommand
+    };
+
+    explicit LocalServerMessage(MessageType type=Reply);
+
+    static LocalServerMessage reply(ReplyStatus status, QString text);
+
+    MessageType getType() const;
+
+    void setProfileLocation(QString location);
+    QString const& getProfileLocation() const;
+
+    // Controller number is one based. Zero addresses every controller.
+    void setControllerNumber(int number);
+    int getControllerNumber() const;
+
+    void setControllerID(QString controllerID);
+    QString const& getControllerID() const;
+
+    // Set number is one based, same as the --startSet option.
+    void setSetNumber(int number);
+    int getSetNumber() const;
+
+    ReplyStatus getStatus() const;
+    QString const& getText() const;
+
+    QByteArray toFrame() const;
+
+    /**
+     * @brief Remove the first complete frame from buffer and decode it.
+     * @param Bytes received so far
+     * @param Decoded message
+     * @param Set when the buffer cannot hold a valid frame. The connection
+     *     should be dropped in that case.
+     * @return True when a message was decoded
+     */
+    static bool takeFrame(QByteArray &buffer, LocalServerMessage &message, bool &malformed);
+
+    static const quint32 MAXFRAMESIZE = 64 * 1024;
+    static const int REPLYTIMEOUT = 2000;
+
+private:
+    MessageType type;
+    QString profileLocation;
+    int controllerNumber;
+    QString controllerID;
+    int setNumber;
+    ReplyStatus status;
+    QString text;
+};
+
+#endif // LOCALSERVERMESSAGE_H
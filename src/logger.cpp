@@ -16,16 +16,46 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-
 #include "logger.h"
 
 #include "messagehandler.h"
 
-#include <QTime>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QDir>
+#include <QFileInfo>
+#include <QtConcurrent>
 #include <QDebug>
 
+#include <zlib.h>
+
 Logger* Logger::instance = nullptr;
 
+
+/**
+ * @brief Background thread writing queued messages to the current streams.
+ */
+class LogWriterThread : public QThread
+{
+public:
+    explicit LogWriterThread(Logger *logger) :
+        QThread(logger),
+        logger(logger)
+    {
+    }
+
+protected:
+    void run() override
+    {
+        logger->runWriter();
+    }
+
+private:
+    Logger *logger;
+};
+
+
 /**
  * @brief Outputs log messages to a given text stream. Client code
  *     should determine whether it points to a console stream or
@@ -41,14 +71,15 @@ Logger::Logger(QTextStream *stream, LogLevel outputLevel, QObject *parent) :
 
     instance = this;
     instance->outputStream = stream;
-    instance->outputLevel = outputLevel;
+    instance->outputLevel.storeRelease(outputLevel);
     instance->errorStream = nullptr;
-    instance->pendingTimer.setInterval(1);
-    instance->pendingTimer.setSingleShot(true);
     instance->writeTime = false;
+    instance->rotateMaxSize = 0;
+    instance->rotateMaxAge = 0;
+    instance->rotateKeepCount = 0;
+    instance->currentFileOpened = 0;
 
-    connect(instance, &Logger::pendingMessage, instance, &Logger::startPendingTimer);
-    connect(&(instance->pendingTimer), &QTimer::timeout, instance, &Logger::Log);
+    startWriter();
 }
 
 /**
@@ -68,25 +99,32 @@ Logger::Logger(QTextStream *stream, QTextStream *errorStream,
 
     instance = this;
     instance->outputStream = stream;
-    instance->outputLevel = outputLevel;
+    instance->outputLevel.storeRelease(outputLevel);
     instance->errorStream = errorStream;
-    instance->pendingTimer.setInterval(1);
-    instance->pendingTimer.setSingleShot(true);
     instance->writeTime = false;
+    instance->rotateMaxSize = 0;
+    instance->rotateMaxAge = 0;
+    instance->rotateKeepCount = 0;
+    instance->currentFileOpened = 0;
 
-    connect(instance, &Logger::pendingMessage, instance, &Logger::startPendingTimer);
-    connect(&(instance->pendingTimer), &QTimer::timeout, instance, &Logger::Log);
+    startWriter();
 }
 
 /**
- * @brief Close output stream and set instance to 0.
+ * @brief Stop writer thread, write remaining messages and close
+ *     output stream and set instance to 0.
  */
 Logger::~Logger()
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
+    stopWriter();
+    Log();
+    compressJobs.waitForFinished();
     closeLogger();
     closeErrorLogger();
+
+    instance = nullptr;
 }
 
 /**
@@ -100,10 +138,7 @@ void Logger::setLogLevel(LogLevel level)
 
     Q_ASSERT(instance != nullptr);
 
-    QMutexLocker locker(&instance->logMutex);
-    Q_UNUSED(locker);
-
-    instance->outputLevel = level;
+    instance->outputLevel.storeRelease(level);
 }
 
 /**
@@ -116,7 +151,15 @@ Logger::LogLevel Logger::getCurrentLogLevel()
 
     Q_ASSERT(instance != nullptr);
 
-    return instance->outputLevel;
+    return static_cast<LogLevel>(instance->outputLevel.loadAcquire());
+}
+
+/**
+ * @brief Get number of messages waiting for the writer thread.
+ */
+int Logger::getQueueDepth()
+{
+    return (instance != nullptr) ? instance->messageQueue.count() : 0;
 }
 
 void Logger::setCurrentStream(QTextStream *stream)
@@ -132,6 +175,28 @@ void Logger::setCurrentStream(QTextStream *stream)
     instance->outputStream = stream;
 }
 
+/**
+ * @brief Set limits for the log file set with setCurrentLogFile. When the
+ *     file reaches one of them, it is moved aside and compressed in the
+ *     background while logging continues in a new file.
+ * @param Maximal size of a log file in bytes. 0 disables the limit
+ * @param Maximal age of a log file in seconds. 0 disables the limit
+ * @param Number of compressed archives to keep. 0 keeps all of them
+ */
+void Logger::setLogRotation(qint64 maxSize, int maxAge, int keepCount)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    Q_ASSERT(instance != nullptr);
+
+    QMutexLocker locker(&instance->logMutex);
+    Q_UNUSED(locker);
+
+    instance->rotateMaxSize = qMax(0LL, maxSize);
+    instance->rotateMaxAge = qMax(0, maxAge);
+    instance->rotateKeepCount = qMax(0, keepCount);
+}
+
 QTextStream* Logger::getCurrentStream()
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
@@ -168,12 +233,9 @@ QTextStream* Logger::getCurrentErrorStream()
 }
 
 /**
- * @brief Go through a list of pending messages and check if message should be
- *     logged according to the set log level. Log the message to the output
- *     stream.
- * @param Log level
- * @param String to write to output stream if appropriate to the current
- *     log level.
+ * @brief Write all queued messages on the calling thread and flush
+ *     the streams. Used when messages have to be on disk right away,
+ *     for example before the application exits.
  */
 void Logger::Log()
 {
@@ -182,15 +244,9 @@ void Logger::Log()
     QMutexLocker locker(&logMutex);
     Q_UNUSED(locker);
 
-    QListIterator<LogMessage> iter(getPendingMessages());
-    while (iter.hasNext())
-    {
-        LogMessage pendingMessage = iter.next();
-        logMessage(pendingMessage);
-    }
-
-    pendingMessages.clear();
-    instance->pendingTimer.stop();
+    bool urgent = false;
+    writePendingMessages(urgent);
+    flushStreams();
 }
 
 /**
@@ -237,14 +293,13 @@ void Logger::closeErrorLogger(bool closeStream)
             }
         }
     }
-
-    instance->pendingTimer.stop();
-    instance = nullptr;
 }
 
 /**
- * @brief Append message to list of messages that might get placed in the
- *     log. Messages will be written later.
+ * @brief Append message to the queue of messages that will be placed in the
+ *     log by the writer thread. Messages above the current log level are
+ *     dropped right away. Never blocks, so it is safe to call from the
+ *     input thread.
  * @param Log level
  * @param String to write to output stream if appropriate to the current
  *     log level.
@@ -252,25 +307,28 @@ void Logger::closeErrorLogger(bool closeStream)
  */
 void Logger::appendLog(LogLevel level, const QString &message, bool newline)
 {
-    qInstallMessageHandler(MessageHandler::myMessageOutput);
-
     Q_ASSERT(instance != nullptr);
 
-    QMutexLocker locker(&instance->logMutex);
-    Q_UNUSED(locker);
+    if (!isLogLevelEnabled(level))
+        return;
 
     LogMessage temp;
     temp.level = level;
-    temp.message = QString(message);
+    temp.message = message;
     temp.newline = newline;
+    temp.timestamp = QDateTime::currentMSecsSinceEpoch();
 
-    instance->pendingMessages.append(temp);
+    instance->messageQueue.enqueue(temp);
 
-    emit instance->pendingMessage();
+    if ((level <= LOG_WARNING) || (instance->messageQueue.count() >= WAKEUPQUEUEDEPTH))
+    {
+        instance->writerWakeCondition.wakeOne();
+    }
 }
 
 /**
- * @brief Immediately write a message to a text stream.
+ * @brief Immediately write a message to a text stream. Messages that are
+ *     still queued are written first to keep the order.
  * @param Log level
  * @param String to write to output stream if appropriate to the current
  *   log level.
@@ -282,38 +340,44 @@ void Logger::directLog(LogLevel level, const QString &message, bool newline)
 
     Q_ASSERT(instance != nullptr);
 
+    if (!isLogLevelEnabled(level))
+        return;
+
     QMutexLocker locker(&instance->logMutex);
     Q_UNUSED(locker);
 
     LogMessage temp;
     temp.level = level;
-    temp.message = QString(message);
+    temp.message = message;
     temp.newline = newline;
+    temp.timestamp = QDateTime::currentMSecsSinceEpoch();
 
+    bool urgent = false;
+    instance->writePendingMessages(urgent);
     instance->logMessage(temp);
+    instance->flushStreams();
 }
 
 /**
- * @brief Write an individual message to the text stream.
+ * @brief Write an individual message to the text stream. Stream is not
+ *     flushed. Caller must hold logMutex.
  * @param LogMessage instance for a single message
+ * @return Number of written characters
  */
-void Logger::logMessage(LogMessage msg)
+int Logger::logMessage(LogMessage msg)
 {
-    qInstallMessageHandler(MessageHandler::myMessageOutput);
-
     LogLevel level = msg.level;
-    QString message = msg.message;
-    bool newline = msg.newline;
+    int currentLevel = outputLevel.loadAcquire();
+    int written = 0;
 
-    if ((outputLevel != LOG_NONE) && (level <= outputLevel))
+    if ((currentLevel != LOG_NONE) && (level <= currentLevel))
     {
-        QString displayTime = "";
-        QString initialPrefix = "";
         QString finalMessage = QString();
-        if ((outputLevel > LOG_INFO) || writeTime)
+
+        if ((currentLevel > LOG_INFO) || writeTime)
         {
-            displayTime = QString("[%1] - ").arg(QTime::currentTime().toString("hh:mm:ss.zzz"));
-            initialPrefix = displayTime;
+            QTime messageTime = QDateTime::fromMSecsSinceEpoch(msg.timestamp).time();
+            finalMessage.append(QString("[%1] - ").arg(messageTime.toString("hh:mm:ss.zzz")));
         }
 
         QTextStream *writeStream = outputStream;
@@ -322,40 +386,215 @@ void Logger::logMessage(LogMessage msg)
             writeStream = errorStream;
         }
 
-        finalMessage.append(initialPrefix).append(message);
+        finalMessage.append(msg.message);
 
-        if (newline)
+        if (msg.newline)
         {
             finalMessage.append("\n");
         }
 
-        *writeStream << finalMessage;
-        writeStream->flush();
+        if (writeStream != nullptr)
+        {
+            *writeStream << finalMessage;
+            written = finalMessage.size();
+        }
+
         emit stringWritten(finalMessage);
     }
+
+    return written;
 }
 
 /**
- * @brief Get the associated timer used by the logger.
- * @return QTimer instance
+ * @brief Write every message currently in the queue. Caller must hold
+ *     logMutex. Only one thread can drain the queue at a time, which
+ *     is guaranteed by the mutex.
+ * @param Set to true if one of the messages should be flushed right away
+ * @return Number of written characters
  */
-QTimer* Logger::getLogTimer()
+int Logger::writePendingMessages(bool& urgent)
 {
-    qInstallMessageHandler(MessageHandler::myMessageOutput);
+    int written = 0;
+    LogMessage pendingMessage;
 
-    return &pendingTimer;
+    while (messageQueue.dequeue(pendingMessage))
+    {
+        written += logMessage(pendingMessage);
+
+        if (pendingMessage.level <= LOG_WARNING)
+            urgent = true;
+    }
+
+    return written;
+}
+
+void Logger::flushStreams()
+{
+    if (outputStream != nullptr) outputStream->flush();
+    if (errorStream != nullptr) errorStream->flush();
+}
+
+void Logger::startWriter()
+{
+    writerStopping.storeRelease(0);
+    writerThread = new LogWriterThread(this);
+    writerThread->start(QThread::LowPriority);
+}
+
+void Logger::stopWriter()
+{
+    if (writerThread != nullptr)
+    {
+        writerStopping.storeRelease(1);
+        writerWakeCondition.wakeOne();
+        writerThread->wait();
+
+        delete writerThread;
+        writerThread = nullptr;
+    }
 }
 
 /**
- * @brief Stop the logger's timer if it is currently active.
+ * @brief Compress a rotated log segment next to it as .gz and remove the
+ *     plain segment. Afterwards only the newest archives of the log file
+ *     are kept. Runs on the global thread pool.
+ * @param Path of rotated segment
+ * @param Path of active log file the segment came from
+ * @param Number of archives to keep. 0 keeps all of them
  */
-void Logger::stopLogTimer()
+static void compressLogSegment(QString segmentPath, QString logPath, int keepCount)
 {
-    qInstallMessageHandler(MessageHandler::myMessageOutput);
+    QFile segment(segmentPath);
+    QByteArray archivePath = QString("%1.gz").arg(segmentPath).toLocal8Bit();
+    bool compressed = false;
 
-    if (pendingTimer.isActive())
+    if (segment.open(QIODevice::ReadOnly))
     {
-        pendingTimer.stop();
+        gzFile archive = gzopen(archivePath.constData(), "wb");
+
+        if (archive != nullptr)
+        {
+            compressed = true;
+            QByteArray buffer;
+
+            while (compressed && !(buffer = segment.read(65536)).isEmpty())
+            {
+                compressed = gzwrite(archive, buffer.constData(), static_cast<unsigned>(buffer.size())) == buffer.size();
+            }
+
+            compressed = (gzclose(archive) == Z_OK) && compressed;
+        }
+
+        segment.close();
+    }
+
+    // Keep the plain segment if compression failed so nothing gets lost
+    if (compressed) segment.remove();
+    else QFile::remove(QString::fromLocal8Bit(archivePath));
+
+    if (keepCount > 0)
+    {
+        QFileInfo logInfo(logPath);
+        QDir logDir = logInfo.absoluteDir();
+        QStringList archives = logDir.entryList(QStringList() << QString("%1.*.gz").arg(logInfo.fileName()),
+                                                QDir::Files, QDir::Name);
+
+        // Segment suffixes are timestamps, so name order is age order
+        while (archives.size() > keepCount)
+        {
+            logDir.remove(archives.takeFirst());
+        }
+    }
+}
+
+/**
+ * @brief Check whether the current log file grew over the maximal size or
+ *     is open for longer than the maximal age. Caller must hold logMutex.
+ */
+bool Logger::isRotationNeeded()
+{
+    if ((outputStream != &outFileStream) || !outputFile.isOpen())
+        return false;
+
+    if ((rotateMaxSize > 0) && (outputFile.size() >= rotateMaxSize))
+        return true;
+
+    if ((rotateMaxAge > 0) &&
+        ((QDateTime::currentMSecsSinceEpoch() - currentFileOpened) >= (rotateMaxAge * 1000LL)))
+        return true;
+
+    return false;
+}
+
+/**
+ * @brief Move the current log file aside under a timestamped name, start
+ *     a new one and hand the old one to a background compression job.
+ *     Caller must hold logMutex.
+ */
+void Logger::rotateLogFile()
+{
+    QString logPath = outputFile.fileName();
+    QString segmentPath = QString("%1.%2").arg(logPath)
+            .arg(QDateTime::currentDateTime().toString("yyyyMMdd-hhmmss-zzz"));
+
+    outFileStream.flush();
+    outputFile.close();
+
+    bool renamed = QFile::rename(logPath, segmentPath);
+
+    outputFile.setFileName(logPath);
+    outputFile.open(QIODevice::WriteOnly | QIODevice::Append);
+    outFileStream.setDevice(&outputFile);
+    currentFileOpened = QDateTime::currentMSecsSinceEpoch();
+
+    if (renamed)
+    {
+        compressJobs.addFuture(QtConcurrent::run(compressLogSegment, segmentPath, logPath, rotateKeepCount));
+    }
+}
+
+/**
+ * @brief Main loop of the writer thread. Messages are written in batches.
+ *     Streams are flushed after FLUSHINTERVAL ms, after FLUSHSIZE characters
+ *     or immediately for warnings and errors.
+ */
+void Logger::runWriter()
+{
+    QElapsedTimer sinceFlush;
+    sinceFlush.start();
+    int unflushed = 0;
+    bool stopping = false;
+
+    while (!stopping)
+    {
+        stopping = writerStopping.loadAcquire();
+
+        {
+            QMutexLocker locker(&logMutex);
+            Q_UNUSED(locker);
+
+            bool urgent = false;
+            unflushed += writePendingMessages(urgent);
+
+            if ((unflushed > 0) &&
+                (urgent || stopping || (unflushed >= FLUSHSIZE) || (sinceFlush.elapsed() >= FLUSHINTERVAL)))
+            {
+                flushStreams();
+                unflushed = 0;
+                sinceFlush.restart();
+
+                if (isRotationNeeded()) rotateLogFile();
+            }
+        }
+
+        if (!stopping)
+        {
+            // Producers only wake the writer for urgent messages or long
+            // queues, otherwise the timeout defines the batch period.
+            writerWakeMutex.lock();
+            writerWakeCondition.wait(&writerWakeMutex, FLUSHINTERVAL);
+            writerWakeMutex.unlock();
+        }
     }
 }
 
@@ -390,30 +629,28 @@ bool Logger::getWriteTime()
     return writeTime;
 }
 
-void Logger::startPendingTimer()
-{
-    qInstallMessageHandler(MessageHandler::myMessageOutput);
-
-    Q_ASSERT(instance != nullptr);
-
-    if (!instance->pendingTimer.isActive())
-    {
-        instance->pendingTimer.start();
-    }
-}
-
 void Logger::setCurrentLogFile(QString filename) {
 
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
   Q_ASSERT(instance != nullptr);
-  
-  if( instance->outputFile.isOpen() ) {
-    instance->closeLogger(true);
+
+  {
+    QMutexLocker locker(&instance->logMutex);
+    Q_UNUSED(locker);
+
+    bool urgent = false;
+    instance->writePendingMessages(urgent);
+
+    if( instance->outputFile.isOpen() ) {
+      instance->closeLogger(true);
+    }
+    instance->outputFile.setFileName( filename );
+    instance->outputFile.open( QIODevice::WriteOnly | QIODevice::Append );
+    instance->outFileStream.setDevice( &instance->outputFile );
+    instance->currentFileOpened = QDateTime::currentMSecsSinceEpoch();
   }
-  instance->outputFile.setFileName( filename );
-  instance->outputFile.open( QIODevice::WriteOnly | QIODevice::Append );
-  instance->outFileStream.setDevice( &instance->outputFile );
+
   instance->setCurrentStream( &instance->outFileStream );
   instance->LogInfo(QObject::tr("Logging started"), true, true);
 }
@@ -424,17 +661,20 @@ void Logger::setCurrentErrorLogFile(QString filename) {
 
   Q_ASSERT(instance != nullptr);
 
-  if( instance->errorFile.isOpen() ) {
-    instance->closeErrorLogger(true);
-  }
-  instance->errorFile.setFileName( filename );
-  instance->errorFile.open( QIODevice::WriteOnly | QIODevice::Append );
-  instance->outErrorFileStream.setDevice( &instance->errorFile );
-  instance->setCurrentErrorStream( &instance->outErrorFileStream );
-}
+  {
+    QMutexLocker locker(&instance->logMutex);
+    Q_UNUSED(locker);
 
-QList<Logger::LogMessage> const& Logger::getPendingMessages() {
+    bool urgent = false;
+    instance->writePendingMessages(urgent);
 
-    return pendingMessages;
-}
+    if( instance->errorFile.isOpen() ) {
+      instance->closeErrorLogger(true);
+    }
+    instance->errorFile.setFileName( filename );
+    instance->errorFile.open( QIODevice::WriteOnly | QIODevice::Append );
+    instance->outErrorFileStream.setDevice( &instance->errorFile );
+  }
 
+  instance->setCurrentErrorStream( &instance->outErrorFileStream );
+}
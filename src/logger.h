@@ -20,12 +20,17 @@
 #ifndef LOGGER_H
 #define LOGGER_H
 
+#include "mpscqueue.h"
+
 #include <QObject>
 #include <QMutex>
+#include <QWaitCondition>
+#include <QAtomicInt>
 #include <QTextStream>
 #include <QFile>
-#include <QTimer>
+#include <QFutureSynchronizer>
 
+class QThread;
 
 class Logger : public QObject
 {
@@ -42,6 +47,7 @@ public:
         QString message;
         LogLevel level;
         bool newline;
+        qint64 timestamp; // ms since epoch
     } LogMessage;
 
     explicit Logger(QTextStream *stream, LogLevel outputLevel = LOG_INFO, QObject *parent = nullptr);
@@ -50,25 +56,34 @@ public:
 
     static void setLogLevel(LogLevel level);
     LogLevel getCurrentLogLevel();
-    QList<LogMessage> const& getPendingMessages();
+    static int getQueueDepth();
 
     static void setCurrentStream(QTextStream *stream);
     static void setCurrentLogFile(QString filename);
     static QTextStream* getCurrentStream();
 
+    static void setLogRotation(qint64 maxSize, int maxAge, int keepCount);
+
     static void setCurrentErrorStream(QTextStream *stream);
     static void setCurrentErrorLogFile(QString filename);
     static QTextStream* getCurrentErrorStream();
 
-    QTimer* getLogTimer();
-    void stopLogTimer();
-
     bool getWriteTime();
     void setWriteTime(bool status);
 
     static void appendLog(LogLevel level, const QString &message, bool newline=true);
     static void directLog(LogLevel level, const QString &message, bool newline=true);
 
+    // Check before building an expensive message that would be dropped anyway.
+    inline static bool isLogLevelEnabled(LogLevel level)
+    {
+        if (instance == nullptr)
+            return false;
+
+        int currentLevel = instance->outputLevel.loadAcquire();
+        return (currentLevel != LOG_NONE) && (level <= currentLevel);
+    }
+
     // Some convenience functions that will hopefully speed up
     // logging operations.
     inline static void LogInfo(const QString &message, bool newline=true, bool direct=false)
@@ -127,10 +142,26 @@ public:
 
     static Logger *instance;
 
+    // Time in ms after which written messages are flushed
+    static const int FLUSHINTERVAL = 250;
+    // Number of written characters after which messages are flushed
+    static const int FLUSHSIZE = 16384;
+    // Number of queued messages after which the writer is woken up early
+    static const int WAKEUPQUEUEDEPTH = 64;
+
 protected:
+    friend class LogWriterThread;
+
     void closeLogger(bool closeStream=true);
     void closeErrorLogger(bool closeStream=true);
-    void logMessage(LogMessage msg);
+    int logMessage(LogMessage msg);
+    int writePendingMessages(bool& urgent);
+    void flushStreams();
+    void startWriter();
+    void stopWriter();
+    void runWriter();
+    bool isRotationNeeded();
+    void rotateLogFile();
 
     bool writeTime;
 
@@ -142,21 +173,27 @@ protected:
     QTextStream outErrorFileStream;
     QTextStream *errorStream;
 
-    LogLevel outputLevel;
-    QMutex logMutex;
-    QTimer pendingTimer;
+    QAtomicInt outputLevel;
+    QMutex logMutex; // guards streams. Never taken by appendLog
 
-    QList<LogMessage> pendingMessages;
+    MPSCQueue<LogMessage> messageQueue;
+    QThread *writerThread;
+    QMutex writerWakeMutex;
+    QWaitCondition writerWakeCondition;
+    QAtomicInt writerStopping;
 
+    qint64 rotateMaxSize; // bytes, 0 disables size based rotation
+    int rotateMaxAge; // seconds, 0 disables time based rotation
+    int rotateKeepCount;
+    qint64 currentFileOpened; // ms since epoch
+    QFutureSynchronizer<void> compressJobs;
 
 
 signals:
     void stringWritten(QString text);
-    void pendingMessage();
 
 public slots:
     void Log();
-    void startPendingTimer();
 };
 
 #endif // LOGGER_H
@@ -23,8 +23,11 @@
 #include "inputdaemon.h"
 #include "common.h"
 #include "commandlineutility.h"
+#include "deviceregistry.h"
 #include "autoprofileinfo.h"
 #include "localantimicroserver.h"
+#include "localservermessage.h"
+#include "processlauncher.h"
 #include "antimicrosettings.h"
 #include "applaunchhelper.h"
 #include "antkeymapper.h"
@@ -50,6 +53,7 @@
 #include <QPointer>
 #include <QCommandLineParser>
 #include <QStandardPaths>
+#include <QFileInfo>
 
 
 #ifdef Q_OS_UNIX
@@ -108,6 +112,127 @@ static void deleteInputDevices(QMap<SDL_JoystickID, InputDevice*> *joysticks)
 }
 
 
+// Translate command line options into requests for an already
+// running instance. Same order as MainWindow::alterConfigFromSettings.
+static QList<LocalServerMessage> buildLocalServerRequests(CommandLineUtility &cmdutility)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    QList<LocalServerMessage> requests;
+
+    if (cmdutility.hasError()) return requests;
+
+    if (cmdutility.shouldQueryStats())
+    {
+        requests.append(LocalServerMessage(LocalServerMessage::QueryStats));
+        return requests;
+    }
+
+    if (cmdutility.shouldListControllers())
+    {
+        requests.append(LocalServerMessage(LocalServerMessage::ListControllers));
+    }
+    else if (cmdutility.hasProfile())
+    {
+        LocalServerMessage request(LocalServerMessage::LoadProfile);
+        request.setProfileLocation(QFileInfo(cmdutility.getProfileLocation()).absoluteFilePath());
+
+        if (cmdutility.hasControllerNumber()) request.setControllerNumber(cmdutility.getControllerNumber());
+        else if (cmdutility.hasControllerID()) request.setControllerID(cmdutility.getControllerID());
+
+        requests.append(request);
+    }
+
+    QListIterator<ControllerOptionsInfo> optionIter(cmdutility.getControllerOptionsList());
+
+    while (optionIter.hasNext())
+    {
+        ControllerOptionsInfo temp = optionIter.next();
+        int controllerNumber = temp.hasControllerNumber() ? temp.getControllerNumber() : 0;
+        QString controllerID = (!temp.hasControllerNumber() && temp.hasControllerID()) ? temp.getControllerID() : QString();
+
+        if (temp.hasProfile() || temp.isUnloadRequested())
+        {
+            LocalServerMessage request(temp.hasProfile() ? LocalServerMessage::LoadProfile :
+                                                           LocalServerMessage::UnloadProfile);
+            request.setProfileLocation(temp.getProfileLocation());
+            request.setControllerNumber(controllerNumber);
+            request.setControllerID(controllerID);
+            requests.append(request);
+        }
+
+        if (temp.getStartSetNumber() > 0)
+        {
+            LocalServerMessage request(LocalServerMessage::ChangeSet);
+            request.setSetNumber(temp.getStartSetNumber());
+            request.setControllerNumber(controllerNumber);
+            request.setControllerID(controllerID);
+            requests.append(request);
+        }
+    }
+
+    return requests;
+}
+
+// Send requests to the running instance and print its replies. Returns
+// false when the first reply does not arrive in time, which means the
+// running instance predates the command protocol.
+static bool forwardLocalServerRequests(QLocalSocket &socket, QList<LocalServerMessage> const& requests, int &result)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    QTextStream outstream(stdout);
+    QTextStream errorstream(stderr);
+    QByteArray buffer;
+    int replies = 0;
+    result = 0;
+
+    QListIterator<LocalServerMessage> iter(requests);
+
+    while (iter.hasNext())
+    {
+        socket.write(iter.next().toFrame());
+    }
+
+    socket.flush();
+
+    while (replies < requests.size())
+    {
+        LocalServerMessage reply;
+        bool malformed = false;
+
+        if (LocalServerMessage::takeFrame(buffer, reply, malformed))
+        {
+            replies++;
+
+            if (reply.getStatus() == LocalServerMessage::StatusOk)
+            {
+                if (!reply.getText().isEmpty()) outstream << reply.getText() << endl;
+            }
+            else
+            {
+                errorstream << reply.getText() << endl;
+                result = 1;
+            }
+        }
+        else if (malformed || !socket.waitForReadyRead(LocalServerMessage::REPLYTIMEOUT))
+        {
+            if (replies == 0) return false;
+
+            errorstream << QObject::tr("No reply from the running instance.") << endl;
+            result = 1;
+            break;
+        }
+        else
+        {
+            buffer.append(socket.readAll());
+        }
+    }
+
+    return true;
+}
+
+
 int main(int argc, char *argv[])
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
@@ -181,6 +306,8 @@ int main(int argc, char *argv[])
                 "xtest"}, // default
             {{"list","l"},
                 QCoreApplication::translate("main", "Print information about joysticks detected by SDL. Use only if you have sdl library. You can check your controller index, name or even GUID.")},
+            {"stats",
+                QCoreApplication::translate("main", "Print event counters of the running instance.")},
            // {"display",
            //     QCoreApplication::translate("main", "Use specified display for X11 calls")},
            // {"next",
@@ -222,6 +349,8 @@ int main(int argc, char *argv[])
     ));
     
     parser.addOption(QCommandLineOption(QStringList() << "list" << "l", QObject::trUtf8("Print information about joysticks detected by SDL. Use only if you have sdl library. You can check your controller index, name or even GUID.")));
+
+    parser.addOption(QCommandLineOption("stats", QObject::trUtf8("Print event counters of the running instance.")));
     
     
 #endif
@@ -262,10 +391,9 @@ int main(int argc, char *argv[])
     QMap<SDL_JoystickID, InputDevice*> *joysticks = new QMap<SDL_JoystickID, InputDevice*>();
     QThread *inputEventThread = nullptr;
 
-    // Cross-platform way of performing IPC. Currently,
-    // only establish a connection and then disconnect.
-    // In the future, there might be a reason to actually send
-    // messages to the QLocalServer.
+    // Cross-platform way of performing IPC. Command line
+    // requests are sent to an already running instance as
+    // LocalServerMessage frames.
     QLocalSocket socket;
 
     if ((socket.serverName() == QString()))
@@ -300,7 +428,24 @@ int main(int argc, char *argv[])
     if (socket.state() == QLocalSocket::ConnectedState)
     {
         // An instance of this program is already running.
-        // Save app config and exit.
+        // Hand the requested changes over to it and exit
+        // without initialising SDL.
+        QList<LocalServerMessage> requests = buildLocalServerRequests(cmdutility);
+        int result = 0;
+
+        if (requests.isEmpty() || forwardLocalServerRequests(socket, requests, result))
+        {
+            socket.disconnectFromServer();
+            if ((socket.state() != QLocalSocket::UnconnectedState) && socket.waitForDisconnected(2000)) qDebug() << "Socket disconnected!" << endl;
+
+            delete joysticks;
+            joysticks = nullptr;
+
+            return result;
+        }
+
+        // The running instance does not understand commands. Save
+        // app config and let it reload on disconnect.
         AntiMicroSettings settings(PadderCommon::configFilePath(), QSettings::IniFormat);
 
         // Update log info based on config values
@@ -317,6 +462,11 @@ int main(int argc, char *argv[])
             appLogger.setCurrentErrorStream(nullptr);
         }
 
+        // Log file limits are stored in MiB and hours
+        appLogger.setLogRotation( settings.value("LogMaxSize", 0).toLongLong() * 1024 * 1024,
+                                  settings.value("LogMaxAge", 0).toInt() * 3600,
+                                  settings.value("LogKeepCount", 5).toInt() );
+
         QPointer<InputDaemon> joypad_worker = new InputDaemon(joysticks, &settings, false);
         MainWindow mainWindow(joysticks, &cmdutility, &settings, false);
         mainWindow.fillButtons();
@@ -360,6 +510,15 @@ int main(int argc, char *argv[])
         return result;
     }
 
+    if (cmdutility.shouldQueryStats())
+    {
+        errorstream << QObject::tr("antimicroX is not running.") << endl;
+        delete joysticks;
+        joysticks = nullptr;
+
+        return 1;
+    }
+
     LocalAntiMicroServer *localServer = nullptr;
 
 #ifdef Q_OS_UNIX
@@ -559,6 +718,11 @@ int main(int argc, char *argv[])
         appLogger.setCurrentErrorStream(nullptr);
     }
 
+    // Log file limits are stored in MiB and hours
+    appLogger.setLogRotation( settings->value("LogMaxSize", 0).toLongLong() * 1024 * 1024,
+                              settings->value("LogMaxAge", 0).toInt() * 3600,
+                              settings->value("LogKeepCount", 5).toInt() );
+
     QString targetLang = QLocale::system().name();
 
     if (settings->contains("Language"))
@@ -630,6 +794,8 @@ int main(int argc, char *argv[])
         delete localServer;
         localServer = nullptr;
 
+        DeviceRegistry::deleteInstance();
+
     #ifdef WITH_X11
 
         if (QApplication::platformName() == QStringLiteral("xcb"))
@@ -835,6 +1001,8 @@ int main(int argc, char *argv[])
 #endif
 
     QObject::connect(localServer, &LocalAntiMicroServer::clientdisconnect, mainWindow, &MainWindow::handleInstanceDisconnect);
+    QObject::connect(localServer, &LocalAntiMicroServer::commandReceived, mainWindow, &MainWindow::handleLocalCommand);
+    QObject::connect(mainWindow, &MainWindow::localCommandHandled, localServer, &LocalAntiMicroServer::sendReply);
     QObject::connect(mainWindow, &MainWindow::mappingUpdated,
                      joypad_worker.data(), &InputDaemon::refreshMapping);
     QObject::connect(joypad_worker.data(), &InputDaemon::deviceUpdated,
@@ -889,6 +1057,9 @@ int main(int argc, char *argv[])
 
 #endif
 
+    ProcessLauncher::deleteInstance();
+    DeviceRegistry::deleteInstance();
+
     EventHandlerFactory::getInstance()->handler()->cleanup();
     EventHandlerFactory::getInstance()->deleteInstance();
 
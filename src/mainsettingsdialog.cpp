@@ -26,6 +26,7 @@
 #include "autoprofileinfo.h"
 #include "inputdevice.h"
 #include "antimicrosettings.h"
+#include "deviceregistry.h"
 #include "eventhandlerfactory.h"
 #include "event.h"
 #include "antkeymapper.h"
@@ -189,6 +190,9 @@ MainSettingsDialog::MainSettingsDialog(AntiMicroSettings *settings,
         ui->autoLoadPreviousCheckBox->setChecked(false);
     }
 
+    bool autoReloadProfiles = settings->value("AutoReloadProfiles", false).toBool();
+    ui->autoReloadProfilesCheckBox->setChecked(autoReloadProfiles);
+
     bool launchInTray = settings->value("LaunchInTray", false).toBool();
     if (launchInTray)
     {
@@ -227,6 +231,9 @@ MainSettingsDialog::MainSettingsDialog(AntiMicroSettings *settings,
         ui->weightModifierDoubleSpinBox->setValue(weightModifier);
     }
 
+    bool highResolutionMouse = settings->value("Mouse/HighResolution", false).toBool();
+    ui->highResolutionMouseCheckBox->setChecked(highResolutionMouse);
+
     for (int i = 1; i <= GlobalVariables::JoyButton::MAXIMUMMOUSEREFRESHRATE; i++)
     {
         ui->mouseRefreshRateComboBox->addItem(QString("%1 ms").arg(i), i);
@@ -324,6 +331,8 @@ void MainSettingsDialog::fillControllerMappingsTable()
 
     QHash<QString, QList<QVariant> > tempHash;
 
+    DeviceRegistry::getInstance()->flush();
+
     settings->getLock()->lock();
     settings->beginGroup("Mappings");
 
@@ -469,6 +478,10 @@ void MainSettingsDialog::syncMappingSettings()
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
+    // Write registry changes still pending so they are not lost
+    // when the Mappings group is rebuilt below.
+    DeviceRegistry::getInstance()->flush();
+
     settings->getLock()->lock();
 
     settings->beginGroup("Mappings");
@@ -494,12 +507,15 @@ void MainSettingsDialog::syncMappingSettings()
 
     settings->endGroup();
     settings->getLock()->unlock();
+
+    DeviceRegistry::getInstance()->load(settings);
 }
 
 void MainSettingsDialog::saveNewSettings()
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
+    settings->flushPendingWrites();
     syncMappingSettings();
 
     settings->getLock()->lock();
@@ -574,6 +590,9 @@ void MainSettingsDialog::saveNewSettings()
     bool autoOpenLastProfile = ui->autoLoadPreviousCheckBox->isChecked();
     settings->setValue("AutoOpenLastProfile", autoOpenLastProfile ? "1" : "0");
 
+    bool autoReloadProfiles = ui->autoReloadProfilesCheckBox->isChecked();
+    settings->setValue("AutoReloadProfiles", autoReloadProfiles ? "1" : "0");
+
     bool launchInTray = ui->launchInTrayCheckBox->isChecked();
     settings->setValue("LaunchInTray", launchInTray ? "1" : "0");
 
@@ -627,6 +646,10 @@ void MainSettingsDialog::saveNewSettings()
         JoyButton::setMouseRefreshRate(mouseRefreshRate, GlobalVariables::JoyButton::mouseRefreshRate, GlobalVariables::JoyButton::IDLEMOUSEREFRESHRATE, JoyButton::getMouseHelper(), &GlobalVariables::JoyButton::mouseHistoryX, &GlobalVariables::JoyButton::mouseHistoryY, JoyButton::getTestOldMouseTime(), JoyButton::getStaticMouseEventTimer());
     }
 
+    bool highResolutionMouse = ui->highResolutionMouseCheckBox->isChecked();
+    JoyButton::setHighResolutionMouse(highResolutionMouse, GlobalVariables::JoyButton::highResolutionMouse);
+    settings->setValue("Mouse/HighResolution", highResolutionMouse ? "1" : "0");
+
     int springIndex = ui->springScreenComboBox->currentIndex();
     int springScreen = ui->springScreenComboBox->itemData(springIndex).toInt();
     JoyButton::setSpringModeScreen(springScreen, GlobalVariables::JoyButton::springModeScreen);
@@ -656,6 +679,8 @@ void MainSettingsDialog::saveNewSettings()
 
     settings->sync();
     settings->getLock()->unlock();
+
+    settings->refreshSnapshot();
 }
 
 void MainSettingsDialog::selectDefaultProfileDir()
@@ -1998,6 +2023,7 @@ void MainSettingsDialog::resetGeneralSett()
     ui->minimizeTaskbarCheckBox->setChecked(false);
     ui->hideEmptyCheckBox->setChecked(false);
     ui->autoLoadPreviousCheckBox->setChecked(true);
+    ui->autoReloadProfilesCheckBox->setChecked(false);
     ui->launchInTrayCheckBox->setChecked(false);
     ui->associateProfilesCheckBox->setChecked(true);
     ui->keyRepeatEnableCheckBox->setChecked(false);
@@ -2062,6 +2088,7 @@ void MainSettingsDialog::resetMouseSett()
     ui->historySizeSpinBox->setEnabled(false);
     ui->weightModifierDoubleSpinBox->setValue(0.20);
     ui->weightModifierDoubleSpinBox->setEnabled(false);
+    ui->highResolutionMouseCheckBox->setChecked(false);
 
 #if defined(WITH_X11)
     ui->quitCombLineEdit->clear();
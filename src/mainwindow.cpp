@@ -41,8 +41,13 @@
 #include "common.h"
 #include "gamecontrollermappingdialog.h"
 #include "calibration.h"
+#include "applaunchhelper.h"
+#include "logger.h"
+#include "inputmetrics.h"
+#include "eventhandlerfactory.h"
 #include "xml/inputdevicexml.h"
 #include "xml/joybuttonslotxml.h"
+#include "xmlconfigreader.h"
 
 #if defined(WITH_X11)
     #include "autoprofileinfo.h"
@@ -467,17 +472,13 @@ void MainWindow::fillButtonsMap(QMap<SDL_JoystickID, InputDevice *> *joysticks)
 
 }
 
-// Intermediate slot to be used in Form Designer
+// Intermediate slot to be used in Form Designer. Tabs of devices that are
+// still connected are kept; added and removed devices arrive through
+// addJoyTab and removeJoyTab.
 void MainWindow::startJoystickRefresh()
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
-    ui->stackedWidget->setCurrentIndex(0);
-    ui->actionUpdate_Joysticks->setEnabled(false);
-    ui->actionHide->setEnabled(false);
-    ui->actionQuit->setEnabled(false);
-    removeJoyTabs();
-
     emit joystickRefreshRequested();
 }
 
@@ -600,7 +601,7 @@ void MainWindow::populateTrayIcon()
 
                     duplicatedGamepad = false;
 
-                    QString contrFile = m_settings->value(controlEntryLastSelected).toString();
+                    QString contrFile = m_settings->snapshotValue(controlEntryLastSelected).toString();
 
                     QFileInfo fileInfo(contrFile);
 
@@ -788,6 +789,8 @@ void MainWindow::saveAppConfig()
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
+    m_settings->flushPendingWrites();
+
     if (m_joysticks->size() > 0)
     {
         JoyTabWidget *temptabwidget = qobject_cast<JoyTabWidget*>(ui->tabWidget->widget(0)); // static_cast
@@ -831,19 +834,45 @@ void MainWindow::saveAppConfig()
 
     m_settings->setValue("WindowSize", size());
     m_settings->setValue("WindowPosition", pos());
+
+    m_settings->refreshSnapshot();
 }
 
 void MainWindow::loadAppConfig(bool forceRefresh)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
+    QStringList profiles;
+
     for (int i=0; i < ui->tabWidget->count(); i++)
     {
         JoyTabWidget *tabwidget = qobject_cast<JoyTabWidget*>(ui->tabWidget->widget(i)); // static_cast
         tabwidget->loadSettings(forceRefresh);
+
+        QString profile = tabwidget->getCurrentConfigFile();
+
+        if (!profile.isEmpty() && !profiles.contains(profile))
+            profiles.append(profile);
+    }
+
+    // Tabs apply their selected profile later in the input thread. Start
+    // reading the files of all devices in parallel so that they are not read
+    // one after another there. The tabs queued their profile changes already,
+    // so profiles left over once the queue gets here were not used.
+    if (profiles.size() > 1)
+    {
+        XMLConfigReader::preloadFiles(profiles);
+        QMetaObject::invokeMethod(this, "dropPreloadedProfiles", Qt::QueuedConnection);
     }
 }
 
+void MainWindow::dropPreloadedProfiles()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    XMLConfigReader::dropPreloadedFiles();
+}
+
 void MainWindow::disableFlashActions()
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
@@ -1103,15 +1132,15 @@ void MainWindow::loadConfigFile(QString fileLocation, int joystickIndex)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
-    if ((joystickIndex > 0) && m_joysticks->contains(joystickIndex - 1))
+    if (joystickIndex > 0)
     {
-        JoyTabWidget *widget = qobject_cast<JoyTabWidget*>(ui->tabWidget->widget(joystickIndex-1)); // static_cast
+        JoyTabWidget *widget = getTabByControllerNumber(joystickIndex);
         if (widget != nullptr)
         {
             widget->loadConfigFile(fileLocation);
         }
     }
-    else if (joystickIndex <= 0)
+    else
     {
         for (int i=0; i < ui->tabWidget->count(); i++)
         {
@@ -1173,6 +1202,234 @@ void MainWindow::handleInstanceDisconnect()
     loadAppConfig(true);
 }
 
+/**
+ * @brief Apply a command sent by another instance over the local socket
+ *     and report the outcome back to it. Profile changes are saved to the
+ *     settings so they survive a restart, same as before the command
+ *     protocol existed.
+ * @param Client connection the reply is written to
+ * @param Decoded command
+ */
+void MainWindow::handleLocalCommand(QLocalSocket *socket, LocalServerMessage message)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    int joystickIndex = message.getControllerNumber();
+    QString controllerID = message.getControllerID();
+    QString controllerText = !controllerID.isEmpty() ? controllerID : QString::number(joystickIndex);
+    QString errorText = QString();
+    QString replyText = QString();
+    bool unknownCommand = false;
+
+    switch (message.getType())
+    {
+        case LocalServerMessage::LoadProfile:
+        {
+            QFileInfo profileFileInfo(message.getProfileLocation());
+
+            if (!profileFileInfo.exists())
+            {
+                errorText = tr("Profile location %1 does not exist.").arg(message.getProfileLocation());
+            }
+            else if (!hasLocalCommandTarget(joystickIndex, controllerID))
+            {
+                errorText = tr("Controller %1 is not connected.").arg(controllerText);
+            }
+            else
+            {
+                if (!controllerID.isEmpty()) loadConfigFile(profileFileInfo.absoluteFilePath(), controllerID);
+                else loadConfigFile(profileFileInfo.absoluteFilePath(), joystickIndex);
+
+                saveAppConfig();
+                replyText = tr("Loaded profile %1").arg(profileFileInfo.absoluteFilePath());
+            }
+
+            break;
+        }
+        case LocalServerMessage::UnloadProfile:
+        {
+            if (!hasLocalCommandTarget(joystickIndex, controllerID))
+            {
+                errorText = tr("Controller %1 is not connected.").arg(controllerText);
+            }
+            else
+            {
+                if (!controllerID.isEmpty()) unloadCurrentConfig(controllerID);
+                else unloadCurrentConfig(joystickIndex);
+
+                saveAppConfig();
+                replyText = tr("Unloaded profile");
+            }
+
+            break;
+        }
+        case LocalServerMessage::ChangeSet:
+        {
+            if ((message.getSetNumber() < 1) || (message.getSetNumber() > 8))
+            {
+                errorText = tr("An invalid set number '%1' was specified.").arg(message.getSetNumber());
+            }
+            else if (!hasLocalCommandTarget(joystickIndex, controllerID))
+            {
+                errorText = tr("Controller %1 is not connected.").arg(controllerText);
+            }
+            else
+            {
+                if (!controllerID.isEmpty()) changeStartSetNumber(message.getSetNumber() - 1, controllerID);
+                else changeStartSetNumber(message.getSetNumber() - 1, joystickIndex);
+
+                replyText = tr("Changed to set %1").arg(message.getSetNumber());
+            }
+
+            break;
+        }
+        case LocalServerMessage::ListControllers:
+        {
+            QTextStream outstream(&replyText);
+            AppLaunchHelper::writeControllerList(m_joysticks, outstream);
+            break;
+        }
+        case LocalServerMessage::QueryStats:
+        {
+            replyText = buildStatsText();
+            break;
+        }
+        default:
+        {
+            unknownCommand = true;
+            errorText = tr("Unknown command %1").arg(static_cast<int>(message.getType()));
+            break;
+        }
+    }
+
+    if (unknownCommand)
+        emit localCommandHandled(socket, LocalServerMessage::reply(LocalServerMessage::StatusUnknownCommand, errorText));
+    else if (!errorText.isEmpty())
+        emit localCommandHandled(socket, LocalServerMessage::reply(LocalServerMessage::StatusFailed, errorText));
+    else
+        emit localCommandHandled(socket, LocalServerMessage::reply(LocalServerMessage::StatusOk, replyText));
+}
+
+
+/**
+ * @brief Check that a command sent over the local socket addresses at least
+ *     one connected controller.
+ * @param One based controller number. Zero addresses every controller.
+ * @param Unique identifier of the controller. Takes precedence when not empty.
+ */
+bool MainWindow::hasLocalCommandTarget(int joystickIndex, QString controllerID)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    if (!controllerID.isEmpty())
+    {
+        QListIterator<JoyTabWidget*> iter(ui->tabWidget->findChildren<JoyTabWidget*>());
+
+        while (iter.hasNext())
+        {
+            JoyTabWidget *tab = iter.next();
+
+            if ((tab != nullptr) && (controllerID == tab->getJoystick()->getStringIdentifier()))
+                return true;
+        }
+
+        return false;
+    }
+
+    if (joystickIndex <= 0) return ui->tabWidget->count() > 0;
+
+    return getTabByControllerNumber(joystickIndex) != nullptr;
+}
+
+
+/**
+ * @brief Find the tab of a controller by the index shown in the
+ *     controller list. Neither tab positions nor SDL instance IDs have
+ *     to match that index, so it is compared with every device.
+ * @param One based controller number
+ * @return Tab of the controller or nullptr when it is not connected
+ */
+JoyTabWidget* MainWindow::getTabByControllerNumber(int joystickIndex)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    for (int i = 0; i < ui->tabWidget->count(); i++)
+    {
+        JoyTabWidget *tab = qobject_cast<JoyTabWidget*>(ui->tabWidget->widget(i));
+
+        if ((tab != nullptr) && (tab->getJoystick()->getRealJoyNumber() == joystickIndex))
+            return tab;
+    }
+
+    return nullptr;
+}
+
+
+/**
+ * @brief Build the reply to a stats query. One "name value" pair per line.
+ *     Rates cover the time since the previous query and mouse jitter is
+ *     reset by every query.
+ */
+QString MainWindow::buildStatsText()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    QString statsText = QString();
+    QTextStream outstream(&statsText);
+    outstream.setRealNumberNotation(QTextStream::FixedNotation);
+    outstream.setRealNumberPrecision(1);
+
+    outstream << "controllers " << m_joysticks->size() << endl;
+
+    for (int i = 0; i < ui->tabWidget->count(); i++)
+    {
+        JoyTabWidget *tab = qobject_cast<JoyTabWidget*>(ui->tabWidget->widget(i));
+
+        if (tab != nullptr)
+        {
+            InputDevice *device = tab->getJoystick();
+            QString prefix = QString("controller.%1.").arg(i + 1);
+            int events = device->getInputEventCount();
+
+            outstream << prefix << "name " << device->getSDLName() << endl;
+            outstream << prefix << "id " << device->getStringIdentifier() << endl;
+            outstream << prefix << "set " << (device->getActiveSetNumber() + 1) << endl;
+            outstream << prefix << "profile " << tab->getCurrentConfigName() << endl;
+            outstream << prefix << "events " << events << endl;
+            outstream << prefix << "events_per_sec "
+                      << InputMetrics::ratePerSecond(device->getStringIdentifier() + "/events", events) << endl;
+            outstream << prefix << "coalesced " << device->getCoalescedEventCount() << endl;
+        }
+    }
+
+    BaseEventHandler *handler = EventHandlerFactory::getInstance()->handler();
+
+    if (handler != nullptr)
+    {
+        QString prefix = QString("handler.%1.").arg(handler->getIdentifier());
+        int outputs = handler->getOutputEventCount();
+
+        outstream << prefix << "outputs " << outputs << endl;
+        outstream << prefix << "outputs_per_sec " << InputMetrics::ratePerSecond(prefix + "outputs", outputs) << endl;
+    }
+
+    int mouseTicks = InputMetrics::getMouseTickCount();
+    int timerEvents = InputMetrics::getTimerEventCount();
+    int jitterAverage = 0;
+    int jitterMax = 0;
+    InputMetrics::takeMouseJitter(jitterAverage, jitterMax);
+
+    outstream << "mouse.ticks " << mouseTicks << endl;
+    outstream << "mouse.ticks_per_sec " << InputMetrics::ratePerSecond("mouse.ticks", mouseTicks) << endl;
+    outstream << "mouse.jitter_avg_us " << jitterAverage << endl;
+    outstream << "mouse.jitter_max_us " << jitterMax << endl;
+    outstream << "timers.fired " << timerEvents << endl;
+    outstream << "timers.fired_per_sec " << InputMetrics::ratePerSecond("timers.fired", timerEvents) << endl;
+    outstream << "logger.queue_depth " << Logger::getQueueDepth() << endl;
+
+    return statsText;
+}
+
 
 void MainWindow::openJoystickStatusWindow()
 {
@@ -1258,15 +1515,15 @@ void MainWindow::unloadCurrentConfig(int joystickIndex)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
-    if ((joystickIndex > 0) && m_joysticks->contains(joystickIndex - 1))
+    if (joystickIndex > 0)
     {
-        JoyTabWidget *widget = qobject_cast<JoyTabWidget*> (ui->tabWidget->widget(joystickIndex - 1)); // static_cast
+        JoyTabWidget *widget = getTabByControllerNumber(joystickIndex);
         if (widget != nullptr)
         {
             widget->unloadConfig();
         }
     }
-    else if (joystickIndex <= 0)
+    else
     {
         for (int i = 0; i < ui->tabWidget->count(); i++)
         {
@@ -1348,15 +1605,15 @@ void MainWindow::changeStartSetNumber(int startSetNumber, int joystickIndex)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
-    if ((joystickIndex > 0) && m_joysticks->contains(joystickIndex - 1))
+    if (joystickIndex > 0)
     {
-        JoyTabWidget *widget = qobject_cast<JoyTabWidget*>(ui->tabWidget->widget(joystickIndex - 1));  // static_cast
+        JoyTabWidget *widget = getTabByControllerNumber(joystickIndex);
         if (widget != nullptr)
         {
             widget->changeCurrentSet(startSetNumber);
         }
     }
-    else if (joystickIndex <= 0)
+    else
     {
         for (int i=0; i < ui->tabWidget->count(); i++)
         {
@@ -1399,6 +1656,7 @@ void MainWindow::openMainSettingsDialog()
 
     connect(dialog, &MainSettingsDialog::accepted, this, &MainWindow::populateTrayIcon);
     connect(dialog, &MainSettingsDialog::accepted, this, &MainWindow::checkHideEmptyOption);
+    connect(dialog, &MainSettingsDialog::accepted, this, &MainWindow::refreshProfileWatches);
 
     dialog->show();
 }
@@ -1570,6 +1828,25 @@ void MainWindow::checkHideEmptyOption()
 }
 
 
+/**
+ * @brief Apply the profile reloading option saved in the settings dialog
+ *     to the profiles in use.
+ */
+void MainWindow::refreshProfileWatches()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    for (int i=0; i < ui->tabWidget->count(); i++)
+    {
+        JoyTabWidget *tab = qobject_cast<JoyTabWidget*>(ui->tabWidget->widget(i));
+        if (tab != nullptr)
+        {
+            tab->refreshProfileWatch();
+        }
+    }
+}
+
+
 void MainWindow::openGameControllerMappingWindow(bool openAsMain)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
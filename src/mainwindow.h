@@ -20,6 +20,8 @@
 #ifndef MAINWINDOW_H
 #define MAINWINDOW_H
 
+#include "localservermessage.h"
+
 #include <SDL2/SDL_joystick.h>
 
 #include <QMainWindow>
@@ -34,6 +36,7 @@ class QTranslator;
 class AutoProfileInfo;
 class AutoProfileWatcher;
 class QLocalServer;
+class QLocalSocket;
 class AboutDialog;
 class QAction;
 class QMenu;
@@ -92,6 +95,7 @@ signals:
     void joystickRefreshRequested();
     void readConfig(int index); // MainConfiguration class
     void mappingUpdated(QString mapping, InputDevice *device);
+    void localCommandHandled(QLocalSocket *socket, LocalServerMessage reply);
 
 
 public slots:
@@ -116,6 +120,7 @@ public slots:
     void selectControllerJoyTab(QString GUID);
     void selectControllerJoyTab(int index);
     void handleInstanceDisconnect();
+    void handleLocalCommand(QLocalSocket *socket, LocalServerMessage message);
 
 
 private slots:
@@ -124,6 +129,7 @@ private slots:
     void mainMenuChange(QMenu* tempMenu);
     void disableFlashActions();
     void enableFlashActions();
+    void dropPreloadedProfiles();
 
     void joystickTrayShow(QMenu* tempmenu);
     void singleTrayProfileMenuShow();
@@ -142,6 +148,7 @@ private slots:
     void openMainSettingsDialog();
     void showStickAssignmentDialog();
     void checkHideEmptyOption();
+    void refreshProfileWatches();
 
     void openGameControllerMappingWindow(bool openAsMain=false);
     void propogateMappingUpdate(QString mapping, InputDevice *device);
@@ -151,6 +158,9 @@ private slots:
 
 private:
     void showBatteryLevel(SDL_JoystickPowerLevel powerLevSDL, QString batteryLev, QString percent, InputDevice* device);
+    bool hasLocalCommandTarget(int joystickIndex, QString controllerID);
+    JoyTabWidget* getTabByControllerNumber(int joystickIndex);
+    QString buildStatsText();
 
     Ui::MainWindow *ui;
 
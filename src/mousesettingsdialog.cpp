@@ -264,6 +264,11 @@ void MouseSettingsDialog::updateAccelerationCurvePresetComboBox(JoyButton::JoyMo
             ui->accelerationComboBox->setCurrentIndex(8);
             break;
         }
+        case JoyButton::CustomCurve:
+        {
+            ui->accelerationComboBox->setCurrentIndex(9);
+            break;
+        }
     }
 }
 
@@ -315,6 +320,11 @@ JoyButton::JoyMouseCurve MouseSettingsDialog::getMouseCurveForIndex(int index)
             temp = JoyButton::EasingCubicCurve;
             break;
         }
+        case 9:
+        {
+            temp = JoyButton::CustomCurve;
+            break;
+        }
     }
 
     return temp;
@@ -0,0 +1,126 @@
+/* antimicroX Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ * Copyright (C) 2020 Jagoda Górska <juliagoda.pl@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MPSCQUEUE_H
+#define MPSCQUEUE_H
+
+#include <QAtomicPointer>
+#include <QAtomicInt>
+
+/**
+ * @brief Unbounded lock-free queue for many producers and a single consumer.
+ *     Producers only perform one atomic exchange per enqueue, so they never
+ *     block on each other or on the consumer. dequeue() must only be called
+ *     from one thread at a time.
+ */
+template <typename T>
+class MPSCQueue
+{
+public:
+    MPSCQueue() :
+        head(&stub),
+        tail(&stub)
+    {
+        stub.next.storeRelease(nullptr);
+    }
+
+    ~MPSCQueue()
+    {
+        T temp;
+        while (dequeue(temp)) {}
+    }
+
+    void enqueue(const T& value)
+    {
+        Node *node = new Node;
+        node->value = value;
+
+        queueSize.ref();
+        push(node);
+    }
+
+    bool dequeue(T& value)
+    {
+        Node *current = tail;
+        Node *next = current->next.loadAcquire();
+
+        if (current == &stub)
+        {
+            if (next == nullptr)
+                return false;
+
+            tail = next;
+            current = next;
+            next = next->next.loadAcquire();
+        }
+
+        if (next == nullptr)
+        {
+            // A producer swapped the head but didn't link its node yet.
+            // Its message will be picked up on the next call.
+            if (current != head.loadAcquire())
+                return false;
+
+            push(&stub);
+            next = current->next.loadAcquire();
+
+            if (next == nullptr)
+                return false;
+        }
+
+        tail = next;
+        value = current->value;
+        delete current;
+        queueSize.deref();
+
+        return true;
+    }
+
+    bool isEmpty() const
+    {
+        return queueSize.loadAcquire() <= 0;
+    }
+
+    int count() const
+    {
+        return queueSize.loadAcquire();
+    }
+
+private:
+    Q_DISABLE_COPY(MPSCQueue)
+
+    struct Node
+    {
+        QAtomicPointer<Node> next;
+        T value;
+    };
+
+    void push(Node *node)
+    {
+        node->next.storeRelease(nullptr);
+        Node *previous = head.fetchAndStoreOrdered(node);
+        previous->next.storeRelease(node);
+    }
+
+    Node stub;
+    QAtomicPointer<Node> head;
+    Node *tail;
+    QAtomicInt queueSize;
+};
+
+#endif // MPSCQUEUE_H
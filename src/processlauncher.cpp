@@ -0,0 +1,138 @@
+/* antimicroX Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ * Copyright (C) 2020 Jagoda Górska <juliagoda.pl@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "processlauncher.h"
+
+#include "messagehandler.h"
+#include "event.h"
+
+#include <QProcess>
+#include <QDebug>
+
+
+ProcessLauncher* ProcessLauncher::instance = nullptr;
+QMutex ProcessLauncher::instanceMutex;
+
+
+ProcessLauncher::ProcessLauncher(QObject *parent) :
+    QThread(parent),
+    stopping(0)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+}
+
+ProcessLauncher::~ProcessLauncher()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    wakeMutex.lock();
+    stopping.storeRelease(1);
+    wakeCondition.wakeOne();
+    wakeMutex.unlock();
+
+    wait();
+}
+
+/**
+ * @brief Get the launcher, starting its thread on first use.
+ */
+ProcessLauncher* ProcessLauncher::getInstance()
+{
+    QMutexLocker locker(&instanceMutex);
+
+    if (instance == nullptr)
+    {
+        instance = new ProcessLauncher();
+        instance->start(QThread::LowPriority);
+    }
+
+    return instance;
+}
+
+/**
+ * @brief Stop the launcher thread. Requests still queued are started
+ *     before the thread ends.
+ */
+void ProcessLauncher::deleteInstance()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    QMutexLocker locker(&instanceMutex);
+
+    if (instance != nullptr)
+    {
+        delete instance;
+        instance = nullptr;
+    }
+}
+
+/**
+ * @brief Queue a program to be started. Returns immediately.
+ * @param Location of the program or script
+ * @param Arguments appended to the command line
+ */
+void ProcessLauncher::launch(QString location, QString arguments)
+{
+    launchRequest request;
+    request.location = location;
+    request.arguments = arguments;
+    requests.enqueue(request);
+
+    // Waking under the mutex pairs with the empty check of run() so
+    // a request cannot slip in between the check and the wait.
+    wakeMutex.lock();
+    wakeCondition.wakeOne();
+    wakeMutex.unlock();
+}
+
+void ProcessLauncher::run()
+{
+    launchRequest request;
+
+    forever
+    {
+        while (requests.dequeue(request))
+        {
+            startProgram(request.location, request.arguments);
+        }
+
+        wakeMutex.lock();
+
+        if (requests.isEmpty() && stopping.loadAcquire())
+        {
+            wakeMutex.unlock();
+            break;
+        }
+
+        if (requests.isEmpty()) wakeCondition.wait(&wakeMutex);
+
+        wakeMutex.unlock();
+    }
+}
+
+void ProcessLauncher::startProgram(QString const& location, QString const& arguments)
+{
+    QString command = QString("%1 %2").arg(detectedScriptExt(location)).arg(location);
+
+    if (!arguments.isEmpty()) command.append(" ").append(arguments);
+
+    bool success = QProcess::startDetached(command);
+
+    if (!success) qDebug() << "Script cannot be executed";
+}
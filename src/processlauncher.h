@@ -0,0 +1,69 @@
+/* antimicroX Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ * Copyright (C) 2020 Jagoda Górska <juliagoda.pl@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PROCESSLAUNCHER_H
+#define PROCESSLAUNCHER_H
+
+#include "mpscqueue.h"
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QAtomicInt>
+#include <QString>
+
+
+/**
+ * @brief Starts programs of JoyExecute slots on a thread of its own so
+ *     button processing never waits for script inspection or fork/exec.
+ */
+class ProcessLauncher : public QThread
+{
+    Q_OBJECT
+
+public:
+    static ProcessLauncher* getInstance();
+    static void deleteInstance();
+
+    void launch(QString location, QString arguments=QString());
+
+protected:
+    void run() override;
+
+private:
+    explicit ProcessLauncher(QObject *parent = nullptr);
+    ~ProcessLauncher();
+
+    void startProgram(QString const& location, QString const& arguments);
+
+    struct launchRequest {
+        QString location;
+        QString arguments;
+    };
+
+    MPSCQueue<launchRequest> requests;
+    QMutex wakeMutex;
+    QWaitCondition wakeCondition;
+    QAtomicInt stopping;
+
+    static ProcessLauncher *instance;
+    static QMutex instanceMutex;
+};
+
+#endif // PROCESSLAUNCHER_H
@@ -0,0 +1,192 @@
+/* antimicroX Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ * Copyright (C) 2020 Jagoda Górska <juliagoda.pl@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "responsecurve.h"
+#include "responsecurvetable.h"
+
+#include <QtGlobal>
+#include <algorithm>
+#include <cmath>
+
+
+ResponseCurve::ResponseCurve()
+{
+    m_interpolation = LinearInterpolation;
+}
+
+bool ResponseCurve::isEmpty() const
+{
+    return m_points.isEmpty();
+}
+
+void ResponseCurve::clear()
+{
+    m_points.clear();
+    tangents.clear();
+    m_interpolation = LinearInterpolation;
+}
+
+void ResponseCurve::setPoints(QList<QPointF> const& points)
+{
+    QList<QPointF> tempPoints;
+
+    for (QPointF point : points)
+    {
+        tempPoints.append(QPointF(qBound(0.0, point.x(), 1.0), qBound(0.0, point.y(), 1.0)));
+    }
+
+    std::stable_sort(tempPoints.begin(), tempPoints.end(),
+                     [](QPointF const& first, QPointF const& second) { return first.x() < second.x(); });
+
+    m_points.clear();
+
+    for (QPointF point : tempPoints)
+    {
+        if (!m_points.isEmpty() && qFuzzyCompare(m_points.last().x() + 1.0, point.x() + 1.0))
+            m_points.last() = point;
+        else
+            m_points.append(point);
+    }
+
+    updateTangents();
+}
+
+QList<QPointF> const& ResponseCurve::getPoints() const
+{
+    return m_points;
+}
+
+void ResponseCurve::setInterpolation(Interpolation interpolation)
+{
+    m_interpolation = interpolation;
+    updateTangents();
+}
+
+ResponseCurve::Interpolation ResponseCurve::getInterpolation() const
+{
+    return m_interpolation;
+}
+
+double ResponseCurve::evaluate(double value) const
+{
+    if (m_points.isEmpty())
+        return value;
+
+    if (value <= m_points.first().x())
+        return m_points.first().y();
+
+    if (value >= m_points.last().x())
+        return m_points.last().y();
+
+    int segment = 0;
+
+    while (value > m_points.at(segment + 1).x())
+        segment++;
+
+    QPointF const& start = m_points.at(segment);
+    QPointF const& end = m_points.at(segment + 1);
+    double width = end.x() - start.x();
+    double t = (value - start.x()) / width;
+
+    if ((m_interpolation == SplineInterpolation) && (tangents.size() == m_points.size()))
+    {
+        // Cubic Hermite basis
+        double t2 = t * t;
+        double t3 = t2 * t;
+        double h00 = (2.0 * t3) - (3.0 * t2) + 1.0;
+        double h10 = t3 - (2.0 * t2) + t;
+        double h01 = (-2.0 * t3) + (3.0 * t2);
+        double h11 = t3 - t2;
+
+        return (h00 * start.y()) + (h10 * width * tangents.at(segment)) +
+               (h01 * end.y()) + (h11 * width * tangents.at(segment + 1));
+    }
+
+    return start.y() + ((end.y() - start.y()) * t);
+}
+
+void ResponseCurve::fillTable(ResponseCurveTable &table) const
+{
+    for (int i = 0; i <= ResponseCurveTable::SEGMENTS; i++)
+    {
+        table.setPoint(i, evaluate(ResponseCurveTable::inputForPoint(i)));
+    }
+}
+
+bool ResponseCurve::operator==(ResponseCurve const& other) const
+{
+    return (m_interpolation == other.m_interpolation) && (m_points == other.m_points);
+}
+
+bool ResponseCurve::operator!=(ResponseCurve const& other) const
+{
+    return !(*this == other);
+}
+
+/**
+ * @brief Fritsch-Carlson tangents. Keeps the spline monotone wherever the
+ *     control points are, so aim curves never bend backwards.
+ */
+void ResponseCurve::updateTangents()
+{
+    tangents.clear();
+
+    if ((m_interpolation != SplineInterpolation) || (m_points.size() < 2))
+        return;
+
+    int count = m_points.size();
+    QVector<double> slopes(count - 1);
+
+    for (int i = 0; i < count - 1; i++)
+    {
+        slopes[i] = (m_points.at(i + 1).y() - m_points.at(i).y()) /
+                    (m_points.at(i + 1).x() - m_points.at(i).x());
+    }
+
+    tangents.resize(count);
+    tangents[0] = slopes.first();
+    tangents[count - 1] = slopes.last();
+
+    for (int i = 1; i < count - 1; i++)
+    {
+        tangents[i] = ((slopes.at(i - 1) * slopes.at(i)) <= 0.0) ? 0.0 :
+                      (slopes.at(i - 1) + slopes.at(i)) * 0.5;
+    }
+
+    for (int i = 0; i < count - 1; i++)
+    {
+        if (qFuzzyIsNull(slopes.at(i)))
+        {
+            tangents[i] = 0.0;
+            tangents[i + 1] = 0.0;
+            continue;
+        }
+
+        double alpha = tangents.at(i) / slopes.at(i);
+        double beta = tangents.at(i + 1) / slopes.at(i);
+        double sum = (alpha * alpha) + (beta * beta);
+
+        if (sum > 9.0)
+        {
+            double scale = 3.0 / sqrt(sum);
+            tangents[i] = scale * alpha * slopes.at(i);
+            tangents[i + 1] = scale * beta * slopes.at(i);
+        }
+    }
+}
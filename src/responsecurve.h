@@ -0,0 +1,71 @@
+/* antimicroX Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ * Copyright (C) 2020 Jagoda Górska <juliagoda.pl@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef RESPONSECURVE_H
+#define RESPONSECURVE_H
+
+#include <QList>
+#include <QPointF>
+#include <QVector>
+
+class ResponseCurveTable;
+
+
+/**
+ * @brief User defined response curve described by control points in the
+ *     range of 0.0 to 1.0. Points are joined either by straight lines or
+ *     by a monotone cubic spline that does not overshoot between points.
+ *     An empty curve passes its input through unchanged.
+ */
+class ResponseCurve
+{
+public:
+    enum Interpolation {LinearInterpolation=0, SplineInterpolation};
+
+    ResponseCurve();
+
+    bool isEmpty() const;
+    void clear();
+
+    /**
+     * @brief Replace the control points. Points are sorted by their input
+     *     value and clamped to the range of 0.0 to 1.0. Points sharing an
+     *     input value keep the last one.
+     */
+    void setPoints(QList<QPointF> const& points);
+    QList<QPointF> const& getPoints() const;
+
+    void setInterpolation(Interpolation interpolation);
+    Interpolation getInterpolation() const;
+
+    double evaluate(double value) const;
+    void fillTable(ResponseCurveTable &table) const;
+
+    bool operator==(ResponseCurve const& other) const;
+    bool operator!=(ResponseCurve const& other) const;
+
+private:
+    void updateTangents();
+
+    QList<QPointF> m_points;
+    QVector<double> tangents;
+    Interpolation m_interpolation;
+};
+
+#endif // RESPONSECURVE_H
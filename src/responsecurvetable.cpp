@@ -0,0 +1,64 @@
+/* antimicroX Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ * Copyright (C) 2020 Jagoda Górska <juliagoda.pl@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "responsecurvetable.h"
+
+#include <QtGlobal>
+
+
+ResponseCurveTable::ResponseCurveTable()
+{
+}
+
+bool ResponseCurveTable::isEmpty() const
+{
+    return points.isEmpty();
+}
+
+void ResponseCurveTable::clear()
+{
+    points.clear();
+}
+
+double ResponseCurveTable::inputForPoint(int index)
+{
+    return static_cast<double>(index) / SEGMENTS;
+}
+
+void ResponseCurveTable::setPoint(int index, double value)
+{
+    if (points.isEmpty())
+        points.fill(0.0f, SEGMENTS + 1);
+
+    points[index] = static_cast<float>(value);
+}
+
+double ResponseCurveTable::lookup(double value) const
+{
+    const int fixed = static_cast<int>(qBound(0.0, value, 1.0) * 65536.0);
+    const int index = fixed >> FRACTIONBITS;
+
+    if (index >= SEGMENTS)
+        return points.at(SEGMENTS);
+
+    const float *segment = points.constData() + index;
+    const float fraction = (fixed & ((1 << FRACTIONBITS) - 1)) * (1.0f / (1 << FRACTIONBITS));
+
+    return segment[0] + ((segment[1] - segment[0]) * fraction);
+}
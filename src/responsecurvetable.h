@@ -0,0 +1,61 @@
+/* antimicroX Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ * Copyright (C) 2020 Jagoda Górska <juliagoda.pl@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef RESPONSECURVETABLE_H
+#define RESPONSECURVETABLE_H
+
+#include <QVector>
+
+
+/**
+ * @brief Precomputed samples of a response curve over the range 0.0 to
+ *     1.0. Inputs are quantised to 16 bit fixed point; the upper bits
+ *     select a segment of the table and the lower bits interpolate
+ *     linearly inside of it.
+ */
+class ResponseCurveTable
+{
+public:
+    static const int FRACTIONBITS = 6;
+    static const int SEGMENTS = 65536 >> FRACTIONBITS;
+
+    ResponseCurveTable();
+
+    bool isEmpty() const;
+    void clear();
+
+    /**
+     * @brief Input value sampled by the table point with the given index.
+     * @param Index between 0 and SEGMENTS
+     * @return Value in the range of 0.0 to 1.0
+     */
+    static double inputForPoint(int index);
+    void setPoint(int index, double value);
+
+    /**
+     * @brief Interpolated curve output. Input is clamped to the range
+     *     of 0.0 to 1.0.
+     */
+    double lookup(double value) const;
+
+private:
+    QVector<float> points;
+};
+
+#endif // RESPONSECURVETABLE_H
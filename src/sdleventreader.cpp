@@ -24,6 +24,7 @@
 #include "inputdevice.h"
 #include "antimicrosettings.h"
 #include "common.h"
+#include "deviceregistry.h"
 //#include "logger.h"
 
 #include <SDL2/SDL.h>
@@ -79,26 +80,7 @@ void SDLEventReader::initSDL()
     SDL_JoystickEventState(SDL_ENABLE);
 
     sdlIsOpen = true;
-    settings->getLock()->lock();
-    settings->beginGroup("Mappings");
-    QStringList mappings = settings->allKeys();
-    QStringListIterator iter(mappings);
-
-    while (iter.hasNext())
-    {
-        QString tempstring = iter.next();
-        QString mappingSetting = settings->value(tempstring, QString()).toString();
-
-        if (!mappingSetting.isEmpty())
-        {
-            QByteArray temparray = mappingSetting.toUtf8();
-            char *mapping = temparray.data();
-            SDL_GameControllerAddMapping(mapping); // Let SDL take care of validation
-        }
-    }
-
-    settings->endGroup();
-    settings->getLock()->unlock();
+    loadMappings();
 
     pollRateTimer.stop();
     pollRateTimer.setInterval(pollRate);
@@ -106,6 +88,28 @@ void SDLEventReader::initSDL()
     emit sdlStarted();
 }
 
+/**
+ * @brief Hand the game controller mappings known to the device registry
+ *     to SDL. Open devices are left alone. Does not need to run in the
+ *     thread of the reader: SDL locks its joystick list while adding a
+ *     mapping and the registry has its own lock. InputDaemon::refresh
+ *     calls it from its own thread with inputDaemonMutex held, so no
+ *     input pass opens devices meanwhile.
+ */
+void SDLEventReader::loadMappings()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    QStringListIterator iter(DeviceRegistry::getInstance()->getMappings());
+
+    while (iter.hasNext())
+    {
+        QByteArray temparray = iter.next().toUtf8();
+        char *mapping = temparray.data();
+        SDL_GameControllerAddMapping(mapping); // Let SDL take care of validation
+    }
+}
+
 void SDLEventReader::closeSDL()
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
@@ -37,6 +37,7 @@ public:
     ~SDLEventReader();
 
     bool isSDLOpen();
+    void loadMappings();
 
     QMap<SDL_JoystickID, InputDevice*> *getJoysticks() const;
     AntiMicroSettings *getSettings() const;
@@ -171,6 +171,7 @@ void SetJoystick::deleteButtons()
     }
 
     m_buttons.clear();
+    m_pendingElements.buttons.resize(0);
 }
 
 
@@ -192,6 +193,7 @@ void SetJoystick::deleteAxes()
     }
 
     axes.clear();
+    m_pendingElements.axes.resize(0);
 }
 
 void SetJoystick::deleteSticks()
@@ -212,6 +214,7 @@ void SetJoystick::deleteSticks()
     }
 
     sticks.clear();
+    m_pendingElements.sticks.resize(0);
 }
 
 void SetJoystick::deleteVDpads()
@@ -232,6 +235,7 @@ void SetJoystick::deleteVDpads()
     }
 
     vdpads.clear();
+    m_pendingElements.vdpads.resize(0);
 }
 
 void SetJoystick::deleteHats()
@@ -252,6 +256,7 @@ void SetJoystick::deleteHats()
     }
 
     hats.clear();
+    m_pendingElements.dpads.resize(0);
 }
 
 int SetJoystick::getNumberButtons() const
@@ -356,6 +361,10 @@ void SetJoystick::release()
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
+    m_pendingElements.axes.resize(0);
+    m_pendingElements.dpads.resize(0);
+    m_pendingElements.buttons.resize(0);
+
     QHashIterator<int, JoyAxis*> iterAxes(axes);
 
     while (iterAxes.hasNext())
@@ -482,6 +491,7 @@ void SetJoystick::removeControlStick(int index)
     {
         JoyControlStick *stick = getSticks().value(index);
         sticks.remove(index);
+        m_pendingElements.sticks.removeAll(stick);
         delete stick;
         stick = nullptr;
     }
@@ -519,11 +529,59 @@ void SetJoystick::removeVDPad(int index)
     {
         VDPad *vdpad = getVdpads().value(index);
         vdpads.remove(index);
+        m_pendingElements.vdpads.removeAll(vdpad);
         delete vdpad;
         vdpad = nullptr;
     }
 }
 
+/**
+ * @brief Remember that the element queued an event so that the next
+ *     activation pass of the device only visits changed elements. Called
+ *     when the pending state of the element becomes set.
+ */
+void SetJoystick::addPendingElement(JoyControlStick *stick)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    m_pendingElements.sticks.append(stick);
+}
+
+void SetJoystick::addPendingElement(JoyAxis *axis)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    m_pendingElements.axes.append(axis);
+}
+
+void SetJoystick::addPendingElement(JoyDPad *dpad)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    m_pendingElements.dpads.append(dpad);
+}
+
+void SetJoystick::addPendingElement(VDPad *vdpad)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    m_pendingElements.vdpads.append(vdpad);
+}
+
+void SetJoystick::addPendingElement(JoyButton *button)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    m_pendingElements.buttons.append(button);
+}
+
+SetJoystick::pendingElements& SetJoystick::getPendingElements()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    return m_pendingElements;
+}
+
 int SetJoystick::getIndex() const
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
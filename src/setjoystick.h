@@ -23,6 +23,8 @@
 #include "joyaxis.h"
 #include "xml/setjoystickxml.h"
 
+#include <QVector>
+
 class InputDevice;
 class JoyButton;
 class JoyDPad;
@@ -34,6 +36,17 @@ class SetJoystick : public SetJoystickXml
     Q_OBJECT
 
 public:
+    // Elements that queued an event since the last activation pass, in the
+    // order they were queued.
+    typedef struct _pendingElements
+    {
+        QVector<JoyControlStick*> sticks;
+        QVector<JoyAxis*> axes;
+        QVector<JoyDPad*> dpads;
+        QVector<VDPad*> vdpads;
+        QVector<JoyButton*> buttons;
+    } pendingElements;
+
     explicit SetJoystick(InputDevice *device, int index, QObject *parent=0);
     explicit SetJoystick(InputDevice *device, int index, bool runreset, QObject *parent=0);
     ~SetJoystick();
@@ -83,6 +96,13 @@ public:
     int getCountBtnInList(QString partialName);
     bool isSetEmpty();
 
+    void addPendingElement(JoyControlStick *stick);
+    void addPendingElement(JoyAxis *axis);
+    void addPendingElement(JoyDPad *dpad);
+    void addPendingElement(VDPad *vdpad);
+    void addPendingElement(JoyButton *button);
+    pendingElements& getPendingElements();
+
 protected:
 
     void deleteButtons(); // SetButton class
@@ -172,6 +192,7 @@ private:
     QHash<int, VDPad*> vdpads;
 
     QList<JoyButton*> lastClickedButtons;
+    pendingElements m_pendingElements;
 
     int m_index;
     InputDevice *m_device;
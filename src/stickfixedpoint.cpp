@@ -0,0 +1,255 @@
+/* antimicroX Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ * Copyright (C) 2020 Jagoda Górska <juliagoda.pl@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "stickfixedpoint.h"
+
+
+// atan(2^-i) in degrees as Q16.16 for the CORDIC iterations in bearing()
+static const qint64 cordicAngles[] = {
+    2949120, 1740967, 919879, 466945, 234379, 117304, 58666, 29335,
+    14668, 7334, 3667, 1833, 917, 458, 229, 115, 57, 29, 14, 7, 4, 2, 1
+};
+
+static const int CORDICSTEPS = sizeof(cordicAngles) / sizeof(cordicAngles[0]);
+
+StickFixedPoint::fixed StickFixedPoint::fromDouble(double value)
+{
+    return static_cast<fixed>(qRound64(value * ONE));
+}
+
+double StickFixedPoint::toDouble(fixed value)
+{
+    return static_cast<double>(value) / ONE;
+}
+
+StickFixedPoint::fixed StickFixedPoint::bearing(int axisXValue, int axisYValue)
+{
+    if ((axisXValue == 0) && (axisYValue == 0))
+        return 0;
+
+    // Rotate the vector onto the X axis. The angles needed for that add
+    // up to atan(east / north) inside of the first quadrant.
+    qint64 north = qAbs(static_cast<qint64>(axisYValue)) << 14;
+    qint64 east = qAbs(static_cast<qint64>(axisXValue)) << 14;
+    qint64 angle = 0;
+
+    for (int i = 0; i < CORDICSTEPS; i++)
+    {
+        qint64 tempNorth = north;
+
+        if (east > 0)
+        {
+            north += east >> i;
+            east -= tempNorth >> i;
+            angle += cordicAngles[i];
+        }
+        else
+        {
+            north -= east >> i;
+            east += tempNorth >> i;
+            angle -= cordicAngles[i];
+        }
+    }
+
+    angle = qBound(static_cast<qint64>(0), angle, static_cast<qint64>(90) << FRACTIONBITS);
+
+    const qint64 halfTurn = static_cast<qint64>(180) << FRACTIONBITS;
+    qint64 finalAngle = angle;
+
+    if ((axisXValue >= 0) && (axisYValue > 0))
+    {
+        // SE Quadrant
+        finalAngle = halfTurn - angle;
+    }
+    else if ((axisXValue < 0) && (axisYValue > 0))
+    {
+        // SW Quadrant
+        finalAngle = halfTurn + angle;
+    }
+    else if (axisXValue < 0)
+    {
+        // NW Quadrant
+        finalAngle = (halfTurn * 2) - angle;
+    }
+
+    return static_cast<fixed>(finalAngle);
+}
+
+StickFixedPoint::fixed StickFixedPoint::distanceFromDeadZone(int axisXValue, int axisYValue,
+                                                             int deadZone, int maxZone, fixed circle)
+{
+    qint64 stickRadius = radius(axisXValue, axisYValue);
+    qint64 larger = largerAxis(axisXValue, axisYValue);
+
+    // Whole units like the truncated distance of the floating point version
+    qint64 dist = stickRadius >> FRACTIONBITS;
+
+    return deadZoneRatio(dist, deadZone, larger, circleLarger(stickRadius, larger, circle), maxZone, ONE);
+}
+
+StickFixedPoint::fixed StickFixedPoint::axisDistanceFromDeadZone(int axisValue, int axisXValue, int axisYValue,
+                                                                 int deadZone, int maxZone, fixed circle)
+{
+    qint64 stickRadius = radius(axisXValue, axisYValue);
+
+    if (stickRadius == 0)
+        return 0;
+
+    qint64 larger = largerAxis(axisXValue, axisYValue);
+    qint64 magnitude = qAbs(static_cast<qint64>(axisValue));
+
+    qint64 deadAxis = deadZoneShare(axisValue, axisXValue, axisYValue, deadZone, stickRadius);
+
+    return deadZoneRatio(magnitude, deadAxis, larger, circleLarger(stickRadius, larger, circle), maxZone, 0);
+}
+
+StickFixedPoint::fixed StickFixedPoint::radialDistance(int axisXValue, int axisYValue, int maxZone)
+{
+    return boundedRatio(radius(axisXValue, axisYValue), static_cast<qint64>(maxZone) << FRACTIONBITS);
+}
+
+quint64 StickFixedPoint::squareRoot(quint64 value)
+{
+    quint64 result = 0;
+    quint64 bit = Q_UINT64_C(1) << 62;
+
+    while (bit > value)
+        bit >>= 2;
+
+    while (bit != 0)
+    {
+        if (value >= (result + bit))
+        {
+            value -= result + bit;
+            result = (result >> 1) + bit;
+        }
+        else
+        {
+            result >>= 1;
+        }
+
+        bit >>= 2;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Distance of the stick position from the centre as Q16.16.
+ */
+qint64 StickFixedPoint::radius(int axisXValue, int axisYValue)
+{
+    quint64 squaredDist = static_cast<quint64>(static_cast<qint64>(axisXValue) * axisXValue)
+            + static_cast<quint64>(static_cast<qint64>(axisYValue) * axisYValue);
+
+    return static_cast<qint64>(squareRoot(squaredDist << (FRACTIONBITS * 2)));
+}
+
+/**
+ * @brief Share of the dead zone along one axis rounded to whole units like
+ *     abs(floor(deadZone * axisValue / radius + 0.5)). The estimate from the
+ *     rounded radius is corrected by comparing squares, so values close
+ *     to a half round the same way as with the exact radius.
+ */
+qint64 StickFixedPoint::deadZoneShare(int axisValue, int axisXValue, int axisYValue, int deadZone, qint64 radius)
+{
+    quint64 squaredDist = static_cast<quint64>(static_cast<qint64>(axisXValue) * axisXValue)
+            + static_cast<quint64>(static_cast<qint64>(axisYValue) * axisYValue);
+    quint64 projection = static_cast<quint64>(qAbs(static_cast<qint64>(deadZone) * axisValue));
+    quint64 doubledSquared = (projection * projection) << 2;
+    qint64 share = ((static_cast<qint64>(projection) << FRACTIONBITS) + (radius / 2)) / radius;
+
+    // (2 * share + offset)^2 * squaredDist compared to (2 * projection)^2
+    auto bound = [squaredDist](qint64 value, int offset) {
+        qint64 doubled = (2 * value) + offset;
+        return static_cast<quint64>(doubled * doubled) * squaredDist;
+    };
+
+    if (axisValue >= 0)
+    {
+        // Largest share with share - 0.5 <= exact value
+        while ((share > 0) && (bound(share, -1) > doubledSquared))
+            share--;
+
+        while (bound(share, 1) <= doubledSquared)
+            share++;
+    }
+    else
+    {
+        // Smallest share with share + 0.5 >= exact value
+        while ((share > 0) && (bound(share, -1) >= doubledSquared))
+            share--;
+
+        while (bound(share, 1) < doubledSquared)
+            share++;
+    }
+    return share;
+}
+
+qint64 StickFixedPoint::largerAxis(int axisXValue, int axisYValue)
+{
+    return qMax(qAbs(static_cast<qint64>(axisXValue)), qAbs(static_cast<qint64>(axisYValue)));
+}
+
+/**
+ * @brief Scale of a square stick at the angle of the position, blended
+ *     with the circle adjustment and multiplied by the larger axis value.
+ *     1/max(|sin|, |cos|) of the angle is the radius divided by the larger
+ *     axis value, so the product needs no division.
+ * @return Q16.16 value. The larger axis value itself when no adjustment
+ *     applies.
+ */
+qint64 StickFixedPoint::circleLarger(qint64 radius, qint64 larger, fixed circle)
+{
+    qint64 largerFixed = larger << FRACTIONBITS;
+
+    return (((radius - largerFixed) * circle) >> FRACTIONBITS) + largerFixed;
+}
+
+/**
+ * @brief Distance of a value past the dead zone after both were divided by
+ *     the circle adjustment. The divisions cancel out, which leaves
+ *     (value - deadZone) * larger / (maxZone * circleLarger - deadZone * larger)
+ *     as a single rounding step.
+ * @param Value returned when no range is left between dead zone and max zone
+ * @return Distance in the range of 0.0 to 1.0
+ */
+StickFixedPoint::fixed StickFixedPoint::deadZoneRatio(qint64 value, qint64 deadZone, qint64 larger,
+                                                      qint64 circleLarger, int maxZone, fixed emptyRange)
+{
+    qint64 range = (static_cast<qint64>(maxZone) * circleLarger) - ((deadZone * larger) << FRACTIONBITS);
+
+    if (value <= deadZone)
+        return 0;
+
+    if (range == 0)
+        return emptyRange;
+
+    return boundedRatio(((value - deadZone) * larger) << FRACTIONBITS, range);
+}
+
+StickFixedPoint::fixed StickFixedPoint::boundedRatio(qint64 numerator, qint64 denominator)
+{
+    if (denominator == 0)
+        return (numerator > 0) ? ONE : 0;
+
+    qint64 ratio = (numerator * ONE) / denominator;
+
+    return static_cast<fixed>(qBound(static_cast<qint64>(0), ratio, static_cast<qint64>(ONE)));
+}
@@ -0,0 +1,87 @@
+/* antimicroX Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ * Copyright (C) 2020 Jagoda Górska <juliagoda.pl@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef STICKFIXEDPOINT_H
+#define STICKFIXEDPOINT_H
+
+#include <QtGlobal>
+
+
+/**
+ * @brief Integer implementation of the stick calculations done by
+ *     JoyControlStick. Values are Q16.16 fixed point numbers, so the same
+ *     raw axis values give the same bits on every machine. Used when the
+ *     project is built with WITH_FIXED_POINT_STICK. Diagonal interpolation
+ *     in JoyControlStick and everything done with the distances in
+ *     JoyButton stay in floating point.
+ */
+class StickFixedPoint
+{
+public:
+    typedef qint32 fixed;
+
+    static const int FRACTIONBITS = 16;
+    static const fixed ONE = 1 << FRACTIONBITS;
+
+    static fixed fromDouble(double value);
+    static double toDouble(fixed value);
+
+    /**
+     * @brief Bearing of the stick position where up is 0 degrees and
+     *     angles grow clockwise.
+     * @return Degrees in the range of 0 to 360. 0 for a centred stick.
+     */
+    static fixed bearing(int axisXValue, int axisYValue);
+
+    /**
+     * @brief Radial distance past the dead zone. Square stick positions are
+     *     scaled towards a circle by the given circle adjustment.
+     * @return Distance in the range of 0.0 to 1.0
+     */
+    static fixed distanceFromDeadZone(int axisXValue, int axisYValue, int deadZone,
+                                      int maxZone, fixed circle);
+
+    /**
+     * @brief Distance of one axis past its share of the dead zone, without
+     *     interpolation along the diagonals.
+     * @param Value of the measured axis pointing away from the bearing
+     *     origin, either axisXValue or -axisYValue
+     * @return Distance in the range of 0.0 to 1.0
+     */
+    static fixed axisDistanceFromDeadZone(int axisValue, int axisXValue, int axisYValue,
+                                          int deadZone, int maxZone, fixed circle);
+
+    /**
+     * @brief Radial distance relative to the max zone.
+     * @return Distance in the range of 0.0 to 1.0
+     */
+    static fixed radialDistance(int axisXValue, int axisYValue, int maxZone);
+
+private:
+    static quint64 squareRoot(quint64 value);
+    static qint64 radius(int axisXValue, int axisYValue);
+    static qint64 deadZoneShare(int axisValue, int axisXValue, int axisYValue, int deadZone, qint64 radius);
+    static qint64 largerAxis(int axisXValue, int axisYValue);
+    static qint64 circleLarger(qint64 radius, qint64 larger, fixed circle);
+    static fixed deadZoneRatio(qint64 value, qint64 deadZone, qint64 larger,
+                               qint64 circleLarger, int maxZone, fixed emptyRange);
+    static fixed boundedRatio(qint64 numerator, qint64 denominator);
+};
+
+#endif // STICKFIXEDPOINT_H
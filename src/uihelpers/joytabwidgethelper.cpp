@@ -105,6 +105,11 @@ bool JoyTabWidgetHelper::readConfigFile(QString filepath)
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
     bool result = false;
+
+    // Do not read a profile that is still being written
+    if (this->writer != nullptr)
+        this->writer->waitForWrite();
+
     device->disconnectPropertyUpdatedConnection();
 
     if (device->getActiveSetNumber() != 0)
@@ -129,6 +134,76 @@ bool JoyTabWidgetHelper::readConfigFile(QString filepath)
     return result;
 }
 
+/**
+ * @brief Load a profile, re-initialising only the elements that differ
+ *     from the configuration in use. Falls back to readConfigFile when the
+ *     profiles differ in more than the elements of their sets. Switching
+ *     to another profile starts from the first set with no buttons held,
+ *     like readConfigFile does.
+ * @param Profile to load
+ * @return Whether the profile was loaded without errors
+ */
+bool JoyTabWidgetHelper::reloadConfigFile(QString filepath)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    if (this->writer != nullptr)
+        this->writer->waitForWrite();
+
+    XMLConfigReader *partialReader = new XMLConfigReader;
+    partialReader->setFileName(filepath);
+    partialReader->setJoystick(device);
+
+    device->disconnectPropertyUpdatedConnection();
+
+    bool sameProfile = (this->reader != nullptr) && (this->reader->getFileName() == filepath);
+
+    if (!sameProfile)
+    {
+        if (device->getActiveSetNumber() != 0)
+        {
+            device->setActiveSetNumber(0);
+        }
+
+        device->resetButtonDownCount();
+    }
+
+    bool reloaded = partialReader->reloadChanged();
+    device->establishPropertyUpdatedConnection();
+
+    if (!reloaded)
+    {
+        delete partialReader;
+        return readConfigFile(filepath);
+    }
+
+    if (this->reader != nullptr)
+        this->reader->deleteLater();
+
+    this->reader = partialReader;
+
+    return !this->reader->hasError();
+}
+
+/**
+ * @brief Check whether a profile differs from the configuration in use.
+ * @param Profile to compare
+ * @return Whether loading the profile would change the device
+ */
+bool JoyTabWidgetHelper::configFileDiffers(QString filepath)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    if (this->writer != nullptr)
+        this->writer->waitForWrite();
+
+    XMLConfigReader compareReader;
+    compareReader.setFileName(filepath);
+    compareReader.setJoystick(device);
+
+    return compareReader.differsFromDevice();
+}
+
 bool JoyTabWidgetHelper::readConfigFileWithRevert(QString filepath)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
@@ -139,26 +214,43 @@ bool JoyTabWidgetHelper::readConfigFileWithRevert(QString filepath)
 
 }
 
-bool JoyTabWidgetHelper::writeConfigFile(QString filepath)
+/**
+ * @brief Save the profile of the device. The file is written in the
+ *     background. Failures are reported with configFileWriteFailed and
+ *     the end of the write with configFileWriteFinished.
+ */
+void JoyTabWidgetHelper::writeConfigFile(QString filepath)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
-    bool result = false;
-
-    if (this->writer != nullptr)
+    // Keep the writer so its buffer is reused by later saves
+    if (this->writer == nullptr)
     {
-        this->writer->deleteLater();
-        this->writer = nullptr;
+        this->writer = new XMLConfigWriter;
+        connect(this->writer, &XMLConfigWriter::writeFailed, this, &JoyTabWidgetHelper::configFileWriteFailed);
+        connect(this->writer, &XMLConfigWriter::writeFinished, this, &JoyTabWidgetHelper::configFileWriteFinished);
     }
 
-    this->writer = new XMLConfigWriter;
     this->writer->setFileName(filepath);
     InputDeviceXml* deviceXml = new InputDeviceXml(device);
     this->writer->write(deviceXml);
     delete deviceXml;
+}
 
-    result = !this->writer->hasError();
-    return result;
+/**
+ * @brief Block until the last profile write has finished.
+ * @return Whether the profile was written
+ */
+bool JoyTabWidgetHelper::waitForConfigFileWrite()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    if (this->writer == nullptr)
+        return true;
+
+    this->writer->waitForWrite();
+
+    return !this->writer->hasError();
 }
 
 void JoyTabWidgetHelper::reInitDevice()
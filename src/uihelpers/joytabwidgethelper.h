@@ -50,10 +50,17 @@ protected:
     bool errorOccurred;
     QString lastErrorString;
 
+signals:
+    void configFileWriteFailed(QString errorString);
+    void configFileWriteFinished(QString filepath, bool success);
+
 public slots:
     bool readConfigFile(QString filepath);
+    bool reloadConfigFile(QString filepath);
+    bool configFileDiffers(QString filepath);
     bool readConfigFileWithRevert(QString filepath);
-    bool writeConfigFile(QString filepath);
+    void writeConfigFile(QString filepath);
+    bool waitForConfigFileWrite();
     void reInitDevice();
     void reInitDeviceWithRevert();
 };
@@ -20,6 +20,7 @@
 
 #include "globalvariables.h"
 #include "messagehandler.h"
+#include "setjoystick.h"
 
 #include <QDebug>
 
@@ -315,6 +316,9 @@ void VDPad::queueJoyEvent(bool ignoresets)
 
     Q_UNUSED(ignoresets)
 
+    if (!pendingVDPadEvent && (getParentSet() != nullptr))
+        getParentSet()->addPendingElement(this);
+
     pendingVDPadEvent = true;
 }
 
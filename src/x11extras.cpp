@@ -21,11 +21,16 @@
 #include "globalvariables.h"
 #include "messagehandler.h"
 
+#include <cstdlib>
+#include <cstring>
 #include <unistd.h>
 #include <X11/Xatom.h>
 #include <X11/XKBlib.h>
+#include <X11/Xlib-xcb.h>
+#include <xcb/xcb.h>
 
 #include <QDebug>
+#include <QFile>
 #include <QFileInfo>
 #include <QThreadStorage>
 
@@ -44,6 +49,7 @@ X11Extras::X11Extras(QObject *parent) :
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
     _display = XOpenDisplay(nullptr);
+    internAtoms();
     populateKnownAliases();
     _instance = this;
 
@@ -61,17 +67,6 @@ X11Extras::~X11Extras()
 }
 
 
-template <typename T>
-void freeWindow(T* window)
-{
-    if (window != nullptr)
-    {
-        XFree(window);
-        window = nullptr;
-    }
-}
-
-
 void X11Extras::freeDisplay()
 {
     if (_display != nullptr)
@@ -162,6 +157,7 @@ void X11Extras::syncDisplay()
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
     _display = XOpenDisplay(nullptr);
+    internAtoms();
 }
 
 /**
@@ -175,6 +171,7 @@ void X11Extras::syncDisplay(QString displayString)
 
     QByteArray tempByteArray = displayString.toLocal8Bit();
     _display = XOpenDisplay(tempByteArray.constData());
+    internAtoms();
 }
 
 void X11Extras::setCustomDisplay(QString displayString)
@@ -237,73 +234,40 @@ Window X11Extras::findParentClient(Window window)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
-    Window parent = 0;
-    Window root = 0;
-    Window *children = 0;
-    unsigned int num_children = 0;
     Window finalwindow = 0;
-    Display *display = this->display();
+    QVector<Window> windows(1, window);
+    QVector<windowInformation> infos;
+    QVector<windowTree> trees;
 
-    if (windowIsViewable(display, window) &&
-        isWindowRelevant(display, window))
+    // Window attributes, relevant properties and the tree query of
+    // a level are sent in one batch, so every level costs one round-trip.
+    fetchWindowInfo(windows, false, infos, &trees);
+
+    if (infos.first().viewable && infos.first().relevant)
     {
         finalwindow = window;
     }
     else
     {
-        bool quitTraversal = false;
+        Window parent = trees.first().parent;
+        Window root = trees.first().root;
 
-        while (!quitTraversal)
+        while (!finalwindow && (parent != 0))
         {
-            children = 0;
+            bool reachedRoot = (parent == root);
+            windows[0] = parent;
 
-            if (XQueryTree(display, window, &root, &parent, &children, &num_children))
-            {
-                if (children)
-                {
-                    // must test for NULL
-                    XFree(children);
-                }
+            fetchWindowInfo(windows, false, infos, reachedRoot ? nullptr : &trees);
 
-                if (parent)
-                {
-                    if (windowIsViewable(display, parent) &&
-                        isWindowRelevant(display, parent))
-                    {
-                        quitTraversal = true;
-                        finalwindow = parent;
-                    }
-                    else if (parent == 0)
-                    {
-                        quitTraversal = true;
-                    }
-                    else if (parent == root)
-                    {
-                        quitTraversal = true;
-                    }
-                    else
-                    {
-                        window = parent;
-                    }
-                }
-                else
-                {
-                    quitTraversal = true;
-                }
-            }
+            if (infos.first().viewable && infos.first().relevant)
+                finalwindow = parent;
+            else if (reachedRoot)
+                parent = 0;
             else
-            {
-                quitTraversal = true;
-            }
+                parent = trees.first().parent;
         }
     }
 
-    if (display != nullptr) qDebug() << "display in X11Extras::findParentClient(Window window) exists" << endl;
-    else qDebug() << "display in X11Extras::findParentClient(Window window) doesn't exist" << endl;
-
-    qDebug() << "parent: " << parent << endl;
-    qDebug() << "root: " << root << endl;
-    qDebug() << "num_children: " << num_children << endl;
     qDebug() << "finalwindow: " << finalwindow << endl;
 
     return finalwindow;
@@ -311,7 +275,7 @@ Window X11Extras::findParentClient(Window window)
 }
 
 /**
- * @brief Check window and any parents for the window property "_NET_WM_PID"
+ * @brief Check window for the window property "_NET_WM_PID"
  * @param Window XID for window of interest
  * @return PID of the application instance corresponding to the window
  */
@@ -319,129 +283,147 @@ int X11Extras::getApplicationPid(Window window)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
-    Atom atom, actual_type;
-    int actual_format = 0;
-    unsigned long nitems = 0;
-    unsigned long bytes_after = 0;
-    unsigned char *prop = nullptr;
-    int pid = 0;
-    Window finalwindow = 0;
-    Window parent = 0;
-    Window root = 0;
-    Window *children = nullptr;
-    unsigned int num_children;
-    Display *display = this->display();
-    atom = XInternAtom(display, "_NET_WM_PID", True);
+    return getWindowInfo(window).pid;
+}
 
-    checkPropertyOnWin(windowHasProperty(display, window, atom), window, parent, finalwindow, root, children, display, num_children);
+/**
+ * @brief Find the application file location for a given PID. Locations are
+ *     cached per pid together with the process start time, so repeated checks
+ *     of the same process don't touch /proc. A cached entry is revalidated
+ *     against /proc/<pid>/stat after PIDCACHEREVALIDATETIME ms and dropped
+ *     once the process exits or the pid gets reused.
+ * @param PID of window
+ * @return File location of application
+ */
+QString X11Extras::getApplicationLocation(int pid)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
 
-    if (finalwindow)
+    QString exepath = QString();
+
+    if (pid > 0)
     {
-        int status = 0;
+        if (!appLocationsTimer.isValid()) appLocationsTimer.start();
 
-        status = XGetWindowProperty(display, finalwindow, atom, 0, 1024, false, AnyPropertyType, &actual_type, &actual_format, &nitems, &bytes_after, &prop);
+        qint64 now = appLocationsTimer.elapsed();
+        QHash<int, appLocationInfo>::iterator cached = appLocations.find(pid);
 
-        if ((status == 0) && (prop != nullptr))
+        if ((cached != appLocations.end()) &&
+            ((now - cached.value().validatedAt) < GlobalVariables::X11Extras::PIDCACHEREVALIDATETIME))
         {
-            pid = prop[1] << 8;
-            pid += prop[0];
-            XFree(prop);
+            return cached.value().location;
         }
-    }
-
-    return pid;
-}
 
+        qulonglong startTime = readProcessStartTime(pid);
 
-void X11Extras::checkPropertyOnWin(bool windowCorrected, Window& window, Window& parent, Window& finalwindow, Window& root, Window *children, Display *display, unsigned int& num_children)
-{
-    if (windowCorrected)
-    {
-        finalwindow = window;
-    }
-    else
-    {
-        bool quitTraversal = false;
-
-        while (!quitTraversal)
+        if (startTime == 0)
         {
-            children = nullptr;
+            // Process is gone
+            appLocations.remove(pid);
+        }
+        else if ((cached != appLocations.end()) && (cached.value().startTime == startTime))
+        {
+            cached.value().validatedAt = now;
+            exepath = cached.value().location;
+        }
+        else
+        {
+            exepath = readApplicationLocation(pid);
 
-            if (XQueryTree(display, window, &root, &parent, &children, &num_children))
+            if (!exepath.isEmpty())
             {
-                if (children != nullptr)
-                {
-                    // must be a test for NULL
-                    XFree(children);
-                }
-
-                if (parent)
-                {
-                    if (windowCorrected)
-                    {
-                        quitTraversal = true;
-                        finalwindow = parent;
-                    }
-                    else if (parent == 0)
-                    {
-                        quitTraversal = true;
-                    }
-                    else if (parent == root)
-                    {
-                        quitTraversal = true;
-                    }
-                    else
-                    {
-                        window = parent;
-                    }
-                }
-                else
-                {
-                    quitTraversal = true;
-                }
+                if (appLocations.size() >= GlobalVariables::X11Extras::PIDCACHESIZE)
+                    pruneApplicationLocations();
+
+                appLocationInfo info;
+                info.startTime = startTime;
+                info.validatedAt = now;
+                info.location = exepath;
+                appLocations.insert(pid, info);
             }
             else
             {
-                quitTraversal = true;
+                appLocations.remove(pid);
             }
         }
     }
+
+    return exepath;
 }
 
-/**
- * @brief Find the application file location for a given PID
- * @param PID of window
- * @return File location of application
- */
-QString X11Extras::getApplicationLocation(int pid)
+QString X11Extras::readApplicationLocation(int pid)
 {
-    qInstallMessageHandler(MessageHandler::myMessageOutput);
-
     QString exepath = QString();
+    QString procString = QString("/proc/%1/exe").arg(pid);
+    QFileInfo procFileInfo(procString);
 
-    if (pid > 0)
+    if (procFileInfo.exists())
     {
-        QString procString = QString("/proc/%1/exe").arg(pid);
-        QFileInfo procFileInfo(procString);
+        char buf[1024];
+        QByteArray tempByteArray = procString.toLocal8Bit();
+        ssize_t len = readlink(tempByteArray.constData(), buf, sizeof(buf)-1);
 
-        if (procFileInfo.exists())
+        if (len != -1) buf[len] = '\0';
+
+        if (len > 0)
         {
-            char buf[1024];
-            QByteArray tempByteArray = procString.toLocal8Bit();
-            ssize_t len = readlink(tempByteArray.constData(), buf, sizeof(buf)-1);
+            QString temp = QString::fromUtf8(buf);
 
-            if (len != -1) buf[len] = '\0';
+            if (!temp.isEmpty()) exepath = temp;
+        }
+    }
 
-            if (len > 0)
-            {
-                QString temp = QString::fromUtf8(buf);
+    return exepath;
+}
 
-                if (!temp.isEmpty()) exepath = temp;
-            }
+/**
+ * @brief Read start time of a process (22nd field of /proc/<pid>/stat)
+ * @param PID of process
+ * @return Start time in clock ticks since boot or 0 if process doesn't exist
+ */
+qulonglong X11Extras::readProcessStartTime(int pid)
+{
+    qulonglong startTime = 0;
+    QFile statFile(QString("/proc/%1/stat").arg(pid));
+
+    if (statFile.open(QIODevice::ReadOnly))
+    {
+        QByteArray content = statFile.readAll();
+        statFile.close();
+
+        // Process name is put in parentheses and can contain spaces,
+        // so fields are counted from the last closing parenthesis.
+        // It is followed by field 3 (state).
+        int nameEnd = content.lastIndexOf(')');
+
+        if (nameEnd != -1)
+        {
+            QList<QByteArray> fields = content.mid(nameEnd + 2).split(' ');
+
+            if (fields.size() > 19)
+                startTime = fields.at(19).toULongLong();
         }
     }
 
-    return exepath;
+    return startTime;
+}
+
+void X11Extras::pruneApplicationLocations()
+{
+    QMutableHashIterator<int, appLocationInfo> iter(appLocations);
+
+    while (iter.hasNext())
+    {
+        iter.next();
+
+        if (readProcessStartTime(iter.key()) != iter.value().startTime)
+            iter.remove();
+    }
+
+    // Every cached process is still alive. Start over rather than
+    // letting the cache grow without limit.
+    if (appLocations.size() >= GlobalVariables::X11Extras::PIDCACHESIZE)
+        appLocations.clear();
 }
 
 /**
@@ -456,43 +438,33 @@ Window X11Extras::findClientWindow(Window window)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
-    Window parent = 1;
-    Window root = 0;
-    Window *children = nullptr;
-    unsigned int num_children = 0;
     Window finalwindow = 0;
-    Display *display = this->display();
+    QVector<windowInformation> infos;
+    QVector<windowTree> trees;
+
+    fetchWindowInfo(QVector<Window>(1, window), false, infos, &trees);
 
-    if (windowIsViewable(display, window) &&
-        isWindowRelevant(display, window))
+    if (infos.first().viewable && infos.first().relevant)
     {
         finalwindow = window;
     }
     else
     {
-        XQueryTree(display, window, &root, &parent, &children, &num_children);
+        QVector<Window> children = trees.first().children;
 
-        if (children != nullptr)
+        // Check all children of a level in one batch
+        fetchWindowInfo(children, false, infos);
+
+        for (int i = 0; (i < children.size()) && !finalwindow; i++)
         {
-            for (unsigned int i = 0; (i < num_children) && !finalwindow; i++)
-            {
-                if (windowIsViewable(display, children[i]) &&
-                    isWindowRelevant(display, window))
-                {
-                    finalwindow = children[i];
-                }
-            }
+            if (infos.at(i).viewable && infos.at(i).relevant)
+                finalwindow = children.at(i);
         }
 
-        if (!finalwindow && (children != nullptr))
+        for (int i = 0; (i < children.size()) && !finalwindow; i++)
         {
-            for (unsigned int i = 0; (i < num_children) && !finalwindow; i++)
-            {
-                finalwindow = findClientWindow(children[i]);
-            }
+            finalwindow = findClientWindow(children.at(i));
         }
-
-        freeWindow(children);
     }
 
     return finalwindow;
@@ -503,23 +475,22 @@ bool X11Extras::windowHasProperty(Display *display, Window window, Atom atom)
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
     bool result = false;
+    xcb_connection_t *conn = (display != nullptr) ? XGetXCBConnection(display) : nullptr;
 
-    Atom actual_type;
-    int actual_format = 0;
-    unsigned long nitems = 0;
-    unsigned long bytes_after = 0;
-    unsigned char *prop = nullptr;
-    int status = 0;
-    status = XGetWindowProperty(display, window, atom, 0, 1024, false, AnyPropertyType,
-                                &actual_type, &actual_format, &nitems, &bytes_after,
-                                &prop);
-
-    if ((status == Success) && (prop != nullptr))
+    if ((conn != nullptr) && (atom != None))
     {
-        result = true;
-    }
+        xcb_get_property_cookie_t cookie = xcb_get_property(conn, 0, window, atom, XCB_GET_PROPERTY_TYPE_ANY, 0, 0);
+        xcb_generic_error_t *error = nullptr;
+        xcb_get_property_reply_t *reply = xcb_get_property_reply(conn, cookie, &error);
+
+        if (reply != nullptr)
+        {
+            result = (reply->type != XCB_NONE);
+            free(reply);
+        }
 
-    freeWindow(prop);
+        free(error);
+    }
 
     return result;
 }
@@ -528,16 +499,12 @@ bool X11Extras::windowIsViewable(Display *display, Window window)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
-    bool result = false;
-    XWindowAttributes xwa;
-    XGetWindowAttributes(display, window, &xwa);
+    Q_UNUSED(display)
 
-    if ((xwa.c_class == InputOutput) && (xwa.map_state == IsViewable))
-    {
-        result = true;
-    }
+    QVector<windowInformation> infos;
+    fetchWindowInfo(QVector<Window>(1, window), false, infos);
 
-    return result;
+    return infos.first().viewable;
 }
 
 /**
@@ -552,124 +519,244 @@ bool X11Extras::isWindowRelevant(Display *display, Window window)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
-    bool result = false;
+    Q_UNUSED(display)
 
-    QList<Atom> temp;
-    temp.append(XInternAtom(display, "WM_STATE", True));
-    temp.append(XInternAtom(display, "_NW_WM_STATE", True));
-    temp.append(XInternAtom(display, "_NW_WM_NAME", True));
+    QVector<windowInformation> infos;
+    fetchWindowInfo(QVector<Window>(1, window), false, infos);
 
-    QListIterator<Atom> iter(temp);
+    return infos.first().relevant;
+}
 
-    while (iter.hasNext())
-    {
-        Atom current_atom = iter.next();
+QString X11Extras::getWindowTitle(Window window)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
 
-        if (windowHasProperty(display, window, current_atom))
-        {
-            iter.toBack();
-            result = true;
-        }
-    }
+    qDebug() << "WIN: 0x" << QString::number(window, 16);
 
-    return result;
+    return getWindowInfo(window).title;
 }
 
-QString X11Extras::getWindowTitle(Window window)
+QString X11Extras::getWindowClass(Window window)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
-    QString temp = QString();
+    return getWindowInfo(window).windowClass;
+}
+
+/**
+ * @brief Get title, class, pid, visibility and relevance of a window.
+ *     All properties are requested at once, so it costs a single round-trip
+ *     to the X server.
+ * @param Window XID for window of interest
+ * @return Collected information. Empty fields when a property doesn't exist.
+ */
+struct X11Extras::windowInformation X11Extras::getWindowInfo(Window window)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
 
-    Atom atom, actual_type;
-    int actual_format = 0;
-    unsigned long nitems = 0;
-    unsigned long bytes_after = 0;
-    unsigned char *prop = nullptr;
-    int status = 0;
+    QVector<windowInformation> infos;
+    fetchWindowInfo(QVector<Window>(1, window), true, infos);
 
-    qDebug() << "WIN: 0x" << QString::number(window, 16);
+    return infos.first();
+}
 
-    Display *display = this->display();
-    Atom wm_name = XInternAtom(display, "WM_NAME", True);
-    Atom net_wm_name = XInternAtom(display, "_NET_WM_NAME", True);
-    atom = wm_name;
+xcb_connection_t* X11Extras::connection()
+{
+    return (_display != nullptr) ? XGetXCBConnection(_display) : nullptr;
+}
 
-    QList<Atom> tempList;
-    tempList.append(wm_name);
-    tempList.append(net_wm_name);
-    QListIterator<Atom> iter(tempList);
+void X11Extras::internAtoms()
+{
+    static const char* atomNames[CachedAtomCount] = {
+        "WM_STATE",
+        "_NET_WM_STATE",
+        "_NET_WM_NAME",
+        "WM_NAME",
+        "WM_CLASS",
+        "_NET_WM_PID"
+    };
+
+    xcb_connection_t *conn = connection();
+    xcb_intern_atom_cookie_t cookies[CachedAtomCount];
+
+    for (int i = 0; i < CachedAtomCount; i++)
+    {
+        cachedAtoms[i] = None;
 
-    while (iter.hasNext())
+        if (conn != nullptr)
+            cookies[i] = xcb_intern_atom(conn, 0, static_cast<uint16_t>(strlen(atomNames[i])), atomNames[i]);
+    }
+
+    for (int i = 0; (i < CachedAtomCount) && (conn != nullptr); i++)
     {
-        Atom temp_atom = iter.next();
+        xcb_generic_error_t *error = nullptr;
+        xcb_intern_atom_reply_t *reply = xcb_intern_atom_reply(conn, cookies[i], &error);
 
-        if (windowHasProperty(display, window, temp_atom))
+        if (reply != nullptr)
         {
-            iter.toBack();
-            atom = temp_atom;
+            cachedAtoms[i] = reply->atom;
+            free(reply);
         }
+
+        free(error);
     }
+}
+
+static QByteArray propertyValue(xcb_get_property_reply_t *reply)
+{
+    return QByteArray(static_cast<const char*>(xcb_get_property_value(reply)),
+                      xcb_get_property_value_length(reply));
+}
 
-    status = XGetWindowProperty(display, window, atom, 0, 1024, false, AnyPropertyType,
-                                &actual_type, &actual_format, &nitems, &bytes_after,
-                                &prop);
+/**
+ * @brief Send all requests needed to describe the given windows before
+ *     waiting for any reply. Replies are then collected in the order of
+ *     the requests, so the whole batch costs one round-trip.
+ * @param Windows of interest
+ * @param Also read title, class and pid, not only visibility and relevance
+ * @param Output information. One entry for every window.
+ * @param Optional output trees. One entry for every window when not null.
+ */
+void X11Extras::fetchWindowInfo(QVector<Window> const& windows, bool fullInfo,
+                                QVector<windowInformation>& infos, QVector<windowTree> *trees)
+{
+    infos.fill(windowInformation(), windows.size());
+    if (trees != nullptr) trees->fill(windowTree(), windows.size());
 
-    if ((status == Success) && (prop != nullptr))
+    xcb_connection_t *conn = connection();
+    if ((conn == nullptr) || windows.isEmpty()) return;
+
+    int propCount = fullInfo ? static_cast<int>(CachedAtomCount) : (NetWMNameAtom + 1);
+    QVector<xcb_get_window_attributes_cookie_t> attrCookies(windows.size());
+    QVector<xcb_get_property_cookie_t> propCookies(windows.size() * propCount);
+    QVector<xcb_query_tree_cookie_t> treeCookies(trees != nullptr ? windows.size() : 0);
+
+    for (int i = 0; i < windows.size(); i++)
     {
-        char *tempprop = reinterpret_cast<char*>(prop);
-        temp.append(QString::fromUtf8(tempprop));
+        attrCookies[i] = xcb_get_window_attributes(conn, windows.at(i));
 
-        qDebug() << temp;
+        for (int j = 0; j < propCount; j++)
+        {
+            propCookies[i * propCount + j] = xcb_get_property(conn, 0, windows.at(i), cachedAtoms[j],
+                                                              XCB_GET_PROPERTY_TYPE_ANY, 0, 1024);
+        }
 
+        if (trees != nullptr) treeCookies[i] = xcb_query_tree(conn, windows.at(i));
     }
 
-    freeWindow(prop);
+    for (int i = 0; i < windows.size(); i++)
+    {
+        windowInformation& info = infos[i];
+        info.window = windows.at(i);
 
-    return temp;
-}
+        xcb_generic_error_t *error = nullptr;
+        xcb_get_window_attributes_reply_t *attrReply = xcb_get_window_attributes_reply(conn, attrCookies.at(i), &error);
 
-QString X11Extras::getWindowClass(Window window)
-{
-    qInstallMessageHandler(MessageHandler::myMessageOutput);
+        if (attrReply != nullptr)
+        {
+            info.viewable = (attrReply->_class == XCB_WINDOW_CLASS_INPUT_OUTPUT) &&
+                            (attrReply->map_state == XCB_MAP_STATE_VIEWABLE);
+            free(attrReply);
+        }
 
-    QString temp = QString();
+        free(error);
 
-    Atom atom, actual_type;
-    int actual_format = 0;
-    unsigned long nitems = 0;
-    unsigned long bytes_after = 0;
-    unsigned char *prop = nullptr;
-    int status = 0;
+        QByteArray wmName;
+        QByteArray netWMName;
+        bool hasWMName = false;
 
-    Display *display = this->display();
-    atom = XInternAtom(display, "WM_CLASS", True);
-    status = XGetWindowProperty(display, window, atom, 0, 1024, false, AnyPropertyType,
-                                &actual_type, &actual_format, &nitems, &bytes_after,
-                                &prop);
+        for (int j = 0; j < propCount; j++)
+        {
+            error = nullptr;
+            xcb_get_property_reply_t *reply = xcb_get_property_reply(conn, propCookies.at(i * propCount + j), &error);
+            free(error);
 
-    if ((status == Success) && (prop != nullptr))
-    {
-        qDebug() << nitems;
+            if (reply == nullptr) continue;
+
+            if (reply->type != XCB_NONE)
+            {
+                switch (j)
+                {
+                    case WMStateAtom:
+                        info.relevant = true;
+                        break;
 
-        char *null_char = strchr(reinterpret_cast<char*>(prop), '\0');
-        if (((reinterpret_cast<char*>(prop)) + nitems - 1) > null_char)
+                    case NetWMStateAtom:
+                        info.relevant = true;
+                        break;
+
+                    case NetWMNameAtom:
+                        info.relevant = true;
+                        netWMName = propertyValue(reply);
+                        break;
+
+                    case WMNameAtom:
+                        hasWMName = true;
+                        wmName = propertyValue(reply);
+                        break;
+
+                    case WMClassAtom:
+                    {
+                        // WM_CLASS holds "instance\0class\0". Show both parts
+                        // separated by a space.
+                        QByteArray value = propertyValue(reply);
+                        int nullIndex = value.indexOf('\0');
+
+                        if ((nullIndex != -1) && (nullIndex < (value.size() - 1)))
+                            value[nullIndex] = ' ';
+
+                        nullIndex = value.indexOf('\0');
+                        if (nullIndex != -1) value.truncate(nullIndex);
+
+                        info.windowClass = QString::fromUtf8(value);
+                        break;
+                    }
+
+                    case NetWMPidAtom:
+                        if ((reply->format == 32) && (xcb_get_property_value_length(reply) >= 4))
+                            info.pid = static_cast<int>(*static_cast<uint32_t*>(xcb_get_property_value(reply)));
+
+                        break;
+                }
+            }
+
+            free(reply);
+        }
+
+        if (fullInfo)
         {
-            *(null_char) = ' ';
+            QByteArray title = hasWMName ? wmName : netWMName;
+            int nullIndex = title.indexOf('\0');
+            if (nullIndex != -1) title.truncate(nullIndex);
+
+            info.title = QString::fromUtf8(title);
         }
 
-        char *tempprop = reinterpret_cast<char*>(prop);
-        temp.append(QString::fromUtf8(tempprop));
+        if (trees != nullptr)
+        {
+            error = nullptr;
+            xcb_query_tree_reply_t *treeReply = xcb_query_tree_reply(conn, treeCookies.at(i), &error);
 
-        qDebug() << temp;
-        qDebug() << reinterpret_cast<char*>(prop);
-    }
+            if (treeReply != nullptr)
+            {
+                windowTree& tree = (*trees)[i];
+                tree.root = treeReply->root;
+                tree.parent = treeReply->parent;
 
-    freeWindow(prop);
+                xcb_window_t *children = xcb_query_tree_children(treeReply);
+                int numChildren = xcb_query_tree_children_length(treeReply);
+                tree.children.reserve(numChildren);
 
-    return temp;
-}
+                for (int k = 0; k < numChildren; k++)
+                    tree.children.append(children[k]);
+
+                free(treeReply);
+            }
 
+            free(error);
+        }
+    }
+}
 
 unsigned long X11Extras::getWindowInFocus()
 {
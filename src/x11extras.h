@@ -23,11 +23,14 @@
 #include <QObject>
 #include <QPoint>
 #include <QHash>
+#include <QVector>
+#include <QElapsedTimer>
 
 #include <X11/extensions/XInput.h>
 #include <X11/extensions/XInput2.h>
 
 
+struct xcb_connection_t;
 
 class X11Extras : public QObject
 {
@@ -49,6 +52,23 @@ public:
         }
     };
 
+    struct windowInformation {
+        Window window;
+        bool viewable;
+        bool relevant;
+        int pid;
+        QString title;
+        QString windowClass;
+
+        windowInformation()
+        {
+            window = 0;
+            viewable = false;
+            relevant = false;
+            pid = 0;
+        }
+    };
+
     ~X11Extras();
 
     unsigned long appRootWindow(int screen = -1);
@@ -65,6 +85,7 @@ public:
     static QString getXDisplayString();
     QString getWindowTitle(Window window);
     QString getWindowClass(Window window);
+    struct windowInformation getWindowInfo(Window window);
     unsigned long getWindowInFocus();
     int getGroup1KeySym(int virtualkey);
 
@@ -96,12 +117,51 @@ public slots:
     QPoint getPos();
 
 private:
-    void checkPropertyOnWin(bool windowCorrected, Window& window, Window& parent, Window& finalwindow, Window& root, Window *children, Display *display, unsigned int& num_children);
+    // Atoms interned once per display connection. The first three are
+    // the ones making a window relevant.
+    enum CachedAtom {
+        WMStateAtom = 0,
+        NetWMStateAtom,
+        NetWMNameAtom,
+        WMNameAtom,
+        WMClassAtom,
+        NetWMPidAtom,
+        CachedAtomCount
+    };
+
+    struct windowTree {
+        Window root;
+        Window parent;
+        QVector<Window> children;
+
+        windowTree()
+        {
+            root = 0;
+            parent = 0;
+        }
+    };
+
+    xcb_connection_t* connection();
+    void internAtoms();
+    void fetchWindowInfo(QVector<Window> const& windows, bool fullInfo,
+                         QVector<windowInformation>& infos, QVector<windowTree> *trees = nullptr);
     void freeDisplay();
     void checkFeedback(XFeedbackState *temp, int& num_feedbacks, int& feedback_id);
     void findVirtualPtr(int num_devices, XIDeviceInfo *current_devices, XIDeviceInfo *mouse_device, XIDeviceInfo *all_devices, QString pointerName);
+    QString readApplicationLocation(int pid);
+    qulonglong readProcessStartTime(int pid);
+    void pruneApplicationLocations();
+
+    struct appLocationInfo {
+        qulonglong startTime;
+        qint64 validatedAt;
+        QString location;
+    };
 
     QHash<QString, QString> knownAliases;
+    Atom cachedAtoms[CachedAtomCount];
+    QHash<int, appLocationInfo> appLocations;
+    QElapsedTimer appLocationsTimer;
     Display *_display;
 };
 
@@ -20,6 +20,8 @@
 #include "messagehandler.h"
 #include "inputdevice.h"
 #include "xml/joybuttonxml.h"
+#include "xml/responsecurvexml.h"
+#include "responsecurve.h"
 #include "joybuttontypes/joyaxisbutton.h"
 
 #include <QXmlStreamReader>
@@ -82,6 +84,14 @@ void JoyAxisXml::writeConfig(QXmlStreamWriter *xml)
 
         if (m_joyAxis->getMaxZoneValue() != GlobalVariables::JoyAxis::AXISMAXZONE)
             xml->writeTextElement("maxZone", QString::number(m_joyAxis->getMaxZoneValue()));
+
+        ResponseCurve outputCurve = m_joyAxis->getOutputCurve();
+
+        if (!outputCurve.isEmpty())
+        {
+            ResponseCurveXml curveXml(&outputCurve);
+            curveXml.writeConfig(xml, "outputcurve");
+        }
     }
 
     xml->writeTextElement("center_value", QString::number(m_joyAxis->getAxisCenterCal()));
@@ -150,6 +160,17 @@ bool JoyAxisXml::readMainConfig(QXmlStreamReader *xml)
 
         m_joyAxis->setMaxZoneValue(tempchoice);
     }
+    else if ((xml->name() == "outputcurve") && xml->isStartElement())
+    {
+        found = true;
+        ResponseCurve tempCurve;
+        ResponseCurveXml curveXml(&tempCurve);
+        curveXml.readConfig(xml);
+
+        qDebug() << "From xml config output curve points: " << tempCurve.getPoints().count();
+
+        m_joyAxis->setOutputCurve(tempCurve);
+    }
     else if ((xml->name() == "center_value") && xml->isStartElement())
     {
         found = true;
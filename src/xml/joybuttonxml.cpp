@@ -17,7 +17,9 @@
 
 #include "joybuttonxml.h"
 #include "joybuttonslotxml.h"
+#include "responsecurvexml.h"
 #include "joybutton.h"
+#include "responsecurve.h"
 
 #include "messagehandler.h"
 
@@ -201,6 +203,15 @@ bool JoyButtonXml::readButtonConfig(QXmlStreamReader *xml)
         else if (temptext == "precision") m_joyButton->setMouseCurve(JoyButton::EnhancedPrecisionCurve);
         else if (temptext == "easing-quadratic") m_joyButton->setMouseCurve(JoyButton::EasingQuadraticCurve);
         else if (temptext == "easing-cubic") m_joyButton->setMouseCurve(JoyButton::EasingCubicCurve);
+        else if (temptext == "custom") m_joyButton->setMouseCurve(JoyButton::CustomCurve);
+    }
+    else if ((xml->name() == "mousecustomcurve") && xml->isStartElement())
+    {
+        found = true;
+        ResponseCurve tempCurve;
+        ResponseCurveXml curveXml(&tempCurve);
+        curveXml.readConfig(xml);
+        m_joyButton->setCustomMouseCurve(tempCurve);
     }
     else if ((xml->name() == "mousespringwidth") && xml->isStartElement())
     {
@@ -420,9 +431,21 @@ void JoyButtonXml::writeConfig(QXmlStreamWriter *xml)
                 case JoyButton::EasingCubicCurve:
                     xml->writeTextElement("mouseacceleration", "easing-cubic");
                     break;
+
+                case JoyButton::CustomCurve:
+                    xml->writeTextElement("mouseacceleration", "custom");
+                    break;
             }
         }
 
+        ResponseCurve customCurve = m_joyButton->getCustomMouseCurve();
+
+        if (!customCurve.isEmpty())
+        {
+            ResponseCurveXml curveXml(&customCurve);
+            curveXml.writeConfig(xml, "mousecustomcurve");
+        }
+
         if (m_joyButton->getWheelSpeedX() != GlobalVariables::JoyButton::DEFAULTWHEELX)
             xml->writeTextElement("wheelspeedx", QString::number(m_joyButton->getWheelSpeedX()));
 
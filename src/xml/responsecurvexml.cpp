@@ -0,0 +1,85 @@
+/* antimicroX Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ * Copyright (C) 2020 Jagoda Górska <juliagoda.pl@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "responsecurvexml.h"
+#include "responsecurve.h"
+
+#include "messagehandler.h"
+
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+#include <QDebug>
+
+
+ResponseCurveXml::ResponseCurveXml(ResponseCurve* curve, QObject *parent) : QObject(parent)
+{
+    m_curve = curve;
+}
+
+/**
+ * @brief Read a curve element. The reader is left on the end element of
+ *     the curve like readElementText does for simple elements.
+ */
+void ResponseCurveXml::readConfig(QXmlStreamReader *xml)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    QList<QPointF> tempPoints;
+    QString interpolation = xml->attributes().value("interpolation").toString();
+
+    while (xml->readNextStartElement())
+    {
+        if (xml->name() == "point")
+        {
+            bool validX = false;
+            bool validY = false;
+            double x = xml->attributes().value("x").toString().toDouble(&validX);
+            double y = xml->attributes().value("y").toString().toDouble(&validY);
+
+            if (validX && validY)
+                tempPoints.append(QPointF(x, y));
+            else
+                qDebug() << "Skipping invalid response curve point";
+        }
+
+        xml->skipCurrentElement();
+    }
+
+    m_curve->setInterpolation((interpolation == "spline") ? ResponseCurve::SplineInterpolation :
+                                                            ResponseCurve::LinearInterpolation);
+    m_curve->setPoints(tempPoints);
+}
+
+void ResponseCurveXml::writeConfig(QXmlStreamWriter *xml, QString const& elementName)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    xml->writeStartElement(elementName);
+    xml->writeAttribute("interpolation", (m_curve->getInterpolation() == ResponseCurve::SplineInterpolation) ?
+                                             "spline" : "linear");
+
+    for (QPointF const& point : m_curve->getPoints())
+    {
+        xml->writeEmptyElement("point");
+        xml->writeAttribute("x", QString::number(point.x()));
+        xml->writeAttribute("y", QString::number(point.y()));
+    }
+
+    xml->writeEndElement();
+}
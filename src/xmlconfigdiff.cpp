@@ -0,0 +1,229 @@
+/* antimicroX Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ * Copyright (C) 2020 Jagoda Górska <juliagoda.pl@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "xmlconfigdiff.h"
+
+#include "messagehandler.h"
+
+#include <QSet>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+#include <QDebug>
+
+#include <algorithm>
+
+
+XMLConfigDiff::XMLConfigDiff(QObject *parent) :
+    QObject(parent)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+}
+
+/**
+ * @brief Compare the configuration currently in use with an updated
+ *     profile.
+ * @param Current configuration as written by InputDeviceXml
+ * @param Contents of the updated profile file
+ * @return Whether only elements inside of sets differ. False when either
+ *     document cannot be parsed or anything outside of the sets changed,
+ *     in which case the whole profile has to be read again.
+ */
+bool XMLConfigDiff::compare(QByteArray const& current, QByteArray const& updated)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    changedElements.clear();
+
+    profileLayout currentLayout;
+
+    if (!parse(current, currentLayout) || !parse(updated, updatedLayout))
+        return false;
+
+    if (currentLayout.header != updatedLayout.header)
+        return false;
+
+    QSet<int> setIndexes = currentLayout.sets.keys().toSet();
+    setIndexes.unite(updatedLayout.sets.keys().toSet());
+
+    QSetIterator<int> iter(setIndexes);
+
+    while (iter.hasNext())
+    {
+        int setIndex = iter.next();
+        QHash<QString, QByteArray> currentElements = currentLayout.sets.value(setIndex);
+        QHash<QString, QByteArray> updatedElements = updatedLayout.sets.value(setIndex);
+
+        QSet<QString> keys = currentElements.keys().toSet();
+        keys.unite(updatedElements.keys().toSet());
+
+        QStringList changed;
+        QSetIterator<QString> keyIter(keys);
+
+        while (keyIter.hasNext())
+        {
+            QString key = keyIter.next();
+
+            if (currentElements.value(key) != updatedElements.value(key))
+                changed.append(key);
+        }
+
+        if (!changed.isEmpty())
+            changedElements.insert(setIndex, changed);
+    }
+
+    qDebug() << "Profile differs in" << changedElements.size() << "sets";
+
+    return true;
+}
+
+/**
+ * @brief Get the sets with changed elements, using the index written in
+ *     the profile.
+ */
+QList<int> XMLConfigDiff::getChangedSets()
+{
+    QList<int> result = changedElements.keys();
+    std::sort(result.begin(), result.end());
+
+    return result;
+}
+
+QStringList XMLConfigDiff::getChangedElements(int setIndex)
+{
+    return changedElements.value(setIndex);
+}
+
+/**
+ * @brief Get the updated XML of an element.
+ * @return Element XML or an empty array when the element is no longer
+ *     present in the updated profile
+ */
+QByteArray XMLConfigDiff::getUpdatedElement(int setIndex, QString const& key)
+{
+    return updatedLayout.sets.value(setIndex).value(key);
+}
+
+QString XMLConfigDiff::getUpdatedProfileName()
+{
+    return updatedLayout.profileName;
+}
+
+QString XMLConfigDiff::elementTag(QString const& key)
+{
+    return key.section(':', 0, 0);
+}
+
+int XMLConfigDiff::elementIndex(QString const& key)
+{
+    return key.section(':', 1).toInt();
+}
+
+bool XMLConfigDiff::parse(QByteArray const& data, profileLayout &layout)
+{
+    layout.header.clear();
+    layout.sets.clear();
+    layout.profileName = QString();
+
+    QXmlStreamReader xml(data);
+
+    if (!xml.readNextStartElement())
+        return false;
+
+    // The version of the program that wrote the profile does not matter,
+    // but the profile format does.
+    QByteArray root = xml.name().toString().toUtf8();
+    root.append(' ').append(xml.attributes().value("configversion").toString().toUtf8());
+    layout.header.append(root);
+
+    while (xml.readNextStartElement())
+    {
+        if (xml.name() == "sets")
+        {
+            if (!parseSets(&xml, layout))
+                return false;
+        }
+        else if (xml.name() == "profilename")
+        {
+            layout.profileName = xml.readElementText();
+        }
+        else
+        {
+            layout.header.append(copyElement(&xml));
+        }
+    }
+
+    if (xml.hasError())
+        return false;
+
+    std::sort(layout.header.begin(), layout.header.end());
+
+    return true;
+}
+
+bool XMLConfigDiff::parseSets(QXmlStreamReader *xml, profileLayout &layout)
+{
+    while (xml->readNextStartElement())
+    {
+        if (xml->name() == "set")
+        {
+            int setIndex = xml->attributes().value("index").toString().toInt();
+            QHash<QString, QByteArray> &elements = layout.sets[setIndex];
+
+            while (xml->readNextStartElement())
+            {
+                QString key = QString("%1:%2").arg(xml->name().toString())
+                                              .arg(xml->attributes().value("index").toString());
+                elements.insert(key, copyElement(xml));
+            }
+        }
+        else
+        {
+            xml->skipCurrentElement();
+        }
+    }
+
+    return !xml->hasError();
+}
+
+/**
+ * @brief Copy the element at the current position of the reader without
+ *     whitespace and comments. Leaves the reader at the end element.
+ */
+QByteArray XMLConfigDiff::copyElement(QXmlStreamReader *xml)
+{
+    QByteArray result;
+    QXmlStreamWriter writer(&result);
+    int depth = 0;
+
+    while (!xml->hasError())
+    {
+        if (xml->isStartElement()) depth++;
+        else if (xml->isEndElement()) depth--;
+
+        if (!xml->isComment() && !(xml->isCharacters() && xml->isWhitespace()))
+            writer.writeCurrentToken(*xml);
+
+        if ((depth == 0) || xml->atEnd())
+            break;
+
+        xml->readNext();
+    }
+
+    return result;
+}
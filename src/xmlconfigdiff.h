@@ -0,0 +1,78 @@
+/* antimicroX Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ * Copyright (C) 2020 Jagoda Górska <juliagoda.pl@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMLCONFIGDIFF_H
+#define XMLCONFIGDIFF_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QStringList>
+
+class QXmlStreamReader;
+
+
+/**
+ * @brief Compares two profile documents element by element so a profile
+ *     can be reloaded without resetting elements that did not change.
+ *     Elements of a set are identified by their tag and index attribute,
+ *     such as "button:3". Whitespace, comments and element order do not
+ *     count as changes. Apart from the profile name, anything outside of
+ *     the sets has to be equal.
+ */
+class XMLConfigDiff : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit XMLConfigDiff(QObject *parent = nullptr);
+
+    bool compare(QByteArray const& current, QByteArray const& updated);
+
+    QList<int> getChangedSets();
+    QStringList getChangedElements(int setIndex);
+    QByteArray getUpdatedElement(int setIndex, QString const& key);
+    QString getUpdatedProfileName();
+
+    static QString elementTag(QString const& key);
+    static int elementIndex(QString const& key);
+
+private:
+    typedef struct _profileLayout
+    {
+        // Canonical copies of everything outside of the sets, sorted
+        QList<QByteArray> header;
+        // Kept out of the header so sibling profiles with different
+        // names can still be compared
+        QString profileName;
+        // Set index as written in the profile -> element key -> canonical copy
+        QHash<int, QHash<QString, QByteArray> > sets;
+    } profileLayout;
+
+    bool parse(QByteArray const& data, profileLayout &layout);
+    bool parseSets(QXmlStreamReader *xml, profileLayout &layout);
+    static QByteArray copyElement(QXmlStreamReader *xml);
+
+    profileLayout updatedLayout;
+    QHash<int, QStringList> changedElements;
+
+};
+
+#endif // XMLCONFIGDIFF_H
@@ -36,7 +36,11 @@ XMLConfigMigration::XMLConfigMigration(QXmlStreamReader *reader, QObject *parent
 
     this->reader = reader;
 
-    if (reader->device() && reader->device()->isOpen())
+    // Peek the version from the root element the reader stands on. Profiles
+    // normally reach the reader as the buffer filled by readConfigData() or
+    // preloaded before; the file itself is only read when buffering failed.
+    // The peek works the same for both.
+    if (reader->isStartElement())
     {
         this->fileVersion = reader->attributes().value("configversion").toString().toInt();
     }
@@ -60,7 +64,13 @@ bool XMLConfigMigration::requiresMigration()
     return toMigrate;
 }
 
-QString XMLConfigMigration::migrate()
+/**
+ * @brief Convert the profile to the latest version.
+ * @param Complete profile the reader was given. When empty, the rest of
+ *     the document is first copied out of the reader.
+ * @return Converted profile or an empty string if none is required
+ */
+QString XMLConfigMigration::migrate(QByteArray const& source)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
@@ -68,9 +78,17 @@ QString XMLConfigMigration::migrate()
 
     if (requiresMigration())
     {
-        QString initialData = readConfigToString();
-        reader->clear();
-        reader->addData(initialData);
+        if (!source.isEmpty())
+        {
+            reader->clear();
+            reader->addData(source);
+        }
+        else
+        {
+            QString initialData = readConfigToString();
+            reader->clear();
+            reader->addData(initialData);
+        }
 
         if ((fileVersion >= 2) && (fileVersion <= 5))
         {
@@ -22,6 +22,7 @@
 
 
 #include <QObject>
+#include <QByteArray>
 
 
 class QXmlStreamReader;
@@ -34,7 +35,7 @@ public:
     explicit XMLConfigMigration(QXmlStreamReader *reader, QObject *parent = nullptr);
 
     bool requiresMigration();
-    QString migrate();
+    QString migrate(QByteArray const& source = QByteArray());
 
     const QXmlStreamReader *getReader();
     int getFileVersion() const;
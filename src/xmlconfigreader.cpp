@@ -23,19 +23,38 @@
 #include "inputdevice.h"
 #include "xmlconfigmigration.h"
 #include "xmlconfigwriter.h"
+#include "xmlconfigdiff.h"
 #include "common.h"
 #include "joystick.h"
 
 #include "gamecontroller/gamecontroller.h"
 #include "gamecontroller/xml/gamecontrollerxml.h"
+#include "xml/inputdevicexml.h"
+#include "setjoystick.h"
+#include "joycontrolstick.h"
+#include "joydpad.h"
+#include "vdpad.h"
 #include "common.h"
 
 #include <QDebug>
 #include <QDir>
 #include <QStringList>
 #include <QXmlStreamReader>
+#include <QXmlStreamWriter>
 #include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QtConcurrent>
 
+#include <SDL2/SDL_gamecontroller.h>
+
+#include <limits>
+
+
+QHash<QString, XMLConfigReader::preloadedProfile> XMLConfigReader::preloaded;
+QFuture<XMLConfigReader::preloadedProfile> XMLConfigReader::preloading;
+QStringList XMLConfigReader::preloadingFiles;
+QMutex XMLConfigReader::preloadMutex;
 
 XMLConfigReader::XMLConfigReader(QObject *parent) :
     QObject(parent)
@@ -112,9 +131,22 @@ bool XMLConfigReader::read()
     {
         xml->clear();
 
-        if (!configFile->isOpen())
+        QByteArray data;
+
+        if (readFileData(data, true))
         {
-            configFile->open(QFile::ReadOnly | QFile::Text);
+            xml->addData(data);
+        }
+        else if (readConfigData())
+        {
+            data = fileData;
+            xml->addData(data);
+        }
+        else
+        {
+            if (!configFile->isOpen())
+                configFile->open(QFile::ReadOnly | QFile::Text);
+
             xml->setDevice(configFile);
         }
 
@@ -130,7 +162,7 @@ bool XMLConfigReader::read()
 
             if (migration.requiresMigration())
             {
-                QString migrationString = migration.migrate();
+                QString migrationString = migration.migrate(data);
 
                 if (migrationString.length() > 0)
                 {
@@ -187,6 +219,323 @@ bool XMLConfigReader::read()
     return error;
 }
 
+/**
+ * @brief Read the profile again, re-initialising only the elements whose
+ *     configuration differs from the one in use. Other elements keep
+ *     their runtime state such as held keys, acceleration and the turbo
+ *     phase. The device is not changed when this returns false.
+ * @return Whether the profile was reloaded. False when it has to be
+ *     read with read() instead, e.g. when sticks or virtual dpads were
+ *     associated differently or the profile needs a migration.
+ */
+bool XMLConfigReader::reloadChanged()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    XMLConfigDiff diff;
+
+    if (!compareWithDevice(diff))
+        return false;
+
+    m_joystick->setProfileName(diff.getUpdatedProfileName());
+
+    QListIterator<int> setIter(diff.getChangedSets());
+
+    while (setIter.hasNext())
+    {
+        int setIndex = setIter.next();
+        SetJoystick *set = m_joystick->getJoystick_sets().value(setIndex - 1);
+
+        if (set == nullptr)
+            continue;
+
+        // Reset changed elements and let the set read only their new XML
+        QByteArray setData = QString("<set index=\"%1\">").arg(setIndex).toUtf8();
+        QStringListIterator elementIter(diff.getChangedElements(setIndex));
+
+        while (elementIter.hasNext())
+        {
+            QString key = elementIter.next();
+            resetElement(set, key);
+            setData.append(diff.getUpdatedElement(setIndex, key));
+        }
+
+        setData.append("</set>");
+
+        xml->clear();
+        xml->addData(setData);
+        xml->readNextStartElement();
+        set->readConfig(xml);
+    }
+
+    xml->clear();
+
+    return true;
+}
+
+/**
+ * @brief Check whether the profile holds a configuration other than the
+ *     one in use, e.g. to ignore changes of the file written by the
+ *     program itself.
+ * @return Whether the profile differs or could not be compared
+ */
+bool XMLConfigReader::differsFromDevice()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    XMLConfigDiff diff;
+
+    if (!compareWithDevice(diff))
+        return true;
+
+    return !diff.getChangedSets().isEmpty() ||
+           (diff.getUpdatedProfileName() != m_joystick->getProfileName());
+}
+
+/**
+ * @brief Compare the profile with the configuration of the device in use.
+ * @param Diff receiving the result
+ * @return Whether the profile could be read and compared
+ */
+bool XMLConfigReader::compareWithDevice(XMLConfigDiff &diff)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    if ((configFile == nullptr) || !configFile->exists() || (m_joystick == nullptr))
+        return false;
+
+    QByteArray updated;
+
+    if (!readFileData(updated, false))
+    {
+        if (!readConfigData())
+            return false;
+
+        updated = fileData;
+    }
+
+    QByteArray current;
+    QXmlStreamWriter writer(&current);
+    InputDeviceXml currentXml(m_joystick);
+    writer.writeStartDocument();
+    currentXml.writeConfig(&writer);
+    writer.writeEndDocument();
+
+    return diff.compare(current, updated);
+}
+
+/**
+ * @brief Return a single element of a set to its default settings.
+ * @param Set holding the element
+ * @param Element key as used by XMLConfigDiff
+ */
+void XMLConfigReader::resetElement(SetJoystick *set, QString const& key)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    QString tag = XMLConfigDiff::elementTag(key);
+    int index = XMLConfigDiff::elementIndex(key) - 1;
+    bool controller = (m_joystick->getXmlName() == GlobalVariables::GameController::xmlName);
+
+    if (tag == "button")
+    {
+        JoyButton *button = set->getJoyButton(index);
+        if (button != nullptr) button->reset();
+    }
+    else if (tag == "axis")
+    {
+        JoyAxis *axis = set->getJoyAxis(index);
+
+        if (axis != nullptr)
+        {
+            axis->reset();
+
+            if (m_joystick->hasCalibrationThrottle(index))
+                axis->setInitialThrottle(m_joystick->getCalibrationThrottle(index));
+        }
+    }
+    else if (tag == "trigger")
+    {
+        // Same index mapping as GameControllerSet uses for reading
+        JoyAxis *axis = nullptr;
+
+        if ((index == 0) || (index == 4)) axis = set->getJoyAxis(SDL_CONTROLLER_AXIS_TRIGGERLEFT);
+        else if ((index == 1) || (index == 5)) axis = set->getJoyAxis(SDL_CONTROLLER_AXIS_TRIGGERRIGHT);
+
+        if (axis != nullptr) axis->reset();
+    }
+    else if (tag == "stick")
+    {
+        JoyControlStick *stick = set->getJoyStick(index);
+        if (stick != nullptr) stick->reset();
+    }
+    else if (tag == "dpad")
+    {
+        JoyDPad *dpad = controller ? set->getVDPad(index) : set->getJoyDPad(index);
+        if (dpad != nullptr) dpad->reset();
+    }
+    else if (tag == "vdpad")
+    {
+        VDPad *vdpad = set->getVDPad(index);
+        if (vdpad != nullptr) vdpad->reset();
+    }
+    else if (tag == "name")
+    {
+        set->setName(QString());
+    }
+}
+
+/**
+ * @brief Start reading the given profiles in parallel on the global thread
+ *     pool and return. Readers of these files wait for the results instead
+ *     of reading the files again, so devices that start together do not
+ *     read their profiles one after another. Profiles found earlier and
+ *     not used are dropped.
+ * @param Absolute paths of the profiles
+ */
+void XMLConfigReader::preloadFiles(QStringList const& filenames)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    QMutexLocker locker(&preloadMutex);
+
+    preloading.cancel();
+    preloaded.clear();
+    preloadingFiles.clear();
+
+    for (int i = 0; i < filenames.size(); i++)
+        preloadingFiles.append(QFileInfo(filenames.at(i)).absoluteFilePath());
+
+    preloading = QtConcurrent::mapped(preloadingFiles, &XMLConfigReader::preloadFile);
+}
+
+/**
+ * @brief Drop preloaded profiles that no reader used. Profiles still being
+ *     read are discarded once they are done.
+ */
+void XMLConfigReader::dropPreloadedFiles()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    QMutexLocker locker(&preloadMutex);
+
+    preloading.cancel();
+    preloading = QFuture<preloadedProfile>();
+    preloadingFiles.clear();
+    preloaded.clear();
+}
+
+XMLConfigReader::preloadedProfile XMLConfigReader::preloadFile(QString const& filename)
+{
+    preloadedProfile profile;
+    profile.filePath = filename;
+
+    QFile file(filename);
+
+    if (!file.open(QFile::ReadOnly | QFile::Text))
+        return profile;
+
+    profile.lastModified = QFileInfo(file).lastModified();
+    profile.data = file.readAll();
+    file.close();
+
+    return profile;
+}
+
+/**
+ * @brief Wait for profiles that are still being preloaded and keep them
+ *     until a reader uses them. Call with preloadMutex locked.
+ */
+void XMLConfigReader::collectPreloadedFiles()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    preloading.waitForFinished();
+
+    if (!preloading.isCanceled())
+    {
+        QList<preloadedProfile> results = preloading.results();
+
+        for (int i = 0; i < results.size(); i++)
+        {
+            // Profiles that could not be read are left to read() so that
+            // it reports the error
+            if (!results.at(i).data.isEmpty())
+                preloaded.insert(results.at(i).filePath, results.at(i));
+        }
+    }
+
+    preloading = QFuture<preloadedProfile>();
+    preloadingFiles.clear();
+}
+
+/**
+ * @brief Read the whole profile into fileData and close the file. The
+ *     buffer keeps its capacity between reads. The file is not parsed in
+ *     place, so it can be rewritten by other programs at any time.
+ * @return Whether the profile was read
+ */
+bool XMLConfigReader::readConfigData()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    if (!configFile->isOpen() && !configFile->open(QFile::ReadOnly))
+        return false;
+
+    qint64 size = configFile->size();
+
+    if ((size <= 0) || (size > std::numeric_limits<int>::max()))
+    {
+        configFile->close();
+        return false;
+    }
+
+    fileData.resize(static_cast<int>(size));
+    qint64 bytesRead = configFile->read(fileData.data(), size);
+    configFile->close();
+
+    if (bytesRead <= 0)
+        return false;
+
+    // The file may have been shortened in the meantime
+    fileData.resize(static_cast<int>(bytesRead));
+
+    return true;
+}
+
+/**
+ * @brief Get the preloaded contents of the profile if the file was not
+ *     changed since it was read.
+ * @param Receives the contents of the profile
+ * @param Whether the contents are no longer needed after this call
+ * @return Whether preloaded contents were found
+ */
+bool XMLConfigReader::readFileData(QByteArray &data, bool take)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    QFileInfo fileInfo(*configFile);
+    QString key = fileInfo.absoluteFilePath();
+
+    QMutexLocker locker(&preloadMutex);
+
+    if (preloadingFiles.contains(key))
+        collectPreloadedFiles();
+
+    if (!preloaded.contains(key))
+        return false;
+
+    if (preloaded.value(key).lastModified != fileInfo.lastModified())
+    {
+        preloaded.remove(key);
+        return false;
+    }
+
+    data = take ? preloaded.take(key).data : preloaded.value(key).data;
+
+    return true;
+}
+
 const QString XMLConfigReader::getErrorString()
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
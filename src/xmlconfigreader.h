@@ -22,11 +22,18 @@
 #include <QObject>
 #include <QPointer>
 #include <QStringList>
+#include <QByteArray>
+#include <QDateTime>
+#include <QFuture>
+#include <QHash>
+#include <QMutex>
 
 class InputDevice;
+class SetJoystick;
 class QXmlStreamReader;
 class InputDeviceXml;
 class QFile;
+class XMLConfigDiff;
 
 class XMLConfigReader : public QObject
 {
@@ -40,6 +47,11 @@ public:
     const QString getErrorString();
     bool hasError();
     bool read();
+    bool reloadChanged();
+    bool differsFromDevice();
+
+    static void preloadFiles(QStringList const& filenames);
+    static void dropPreloadedFiles();
 
     const QXmlStreamReader *getXml();
     QString const& getFileName();
@@ -49,7 +61,21 @@ public:
     QStringList const& getDeviceTypes();
 
 protected:
+    typedef struct _preloadedProfile
+    {
+        QString filePath;
+        QByteArray data;
+        QDateTime lastModified;
+    } preloadedProfile;
+
     void initDeviceTypes();
+    void resetElement(SetJoystick *set, QString const& key);
+    bool compareWithDevice(XMLConfigDiff &diff);
+    bool readFileData(QByteArray &data, bool take);
+    bool readConfigData();
+
+    static preloadedProfile preloadFile(QString const& filename);
+    static void collectPreloadedFiles();
     
 public slots:
     void configJoystick(InputDevice *joystick);
@@ -58,9 +84,16 @@ private:
     QXmlStreamReader *xml;
     QString fileName;
     QFile *configFile;
+    // Contents of the profile. Reused between reads.
+    QByteArray fileData;
     InputDevice* m_joystick;
     QStringList deviceTypes;
 
+    static QHash<QString, preloadedProfile> preloaded;
+    static QFuture<preloadedProfile> preloading;
+    static QStringList preloadingFiles;
+    static QMutex preloadMutex;
+
 };
 
 #endif // XMLCONFIGREADER_H
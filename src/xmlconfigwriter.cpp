@@ -24,8 +24,10 @@
 #include "xml/inputdevicexml.h"
 
 #include <QDir>
-#include <QFile>
+#include <QBuffer>
+#include <QSaveFile>
 #include <QXmlStreamWriter>
+#include <QtConcurrent>
 #include <QDebug>
 
 
@@ -36,24 +38,20 @@ XMLConfigWriter::XMLConfigWriter(QObject *parent) :
 
     xml = new QXmlStreamWriter();
     xml->setAutoFormatting(true);
-    configFile = nullptr;
+    buffer.reserve(INITIALBUFFERSIZE);
     m_joystick = nullptr;
     m_joystickXml = nullptr;
     writerError = false;
+    writePending = false;
+
+    connect(&fileWatcher, &QFutureWatcher<QString>::finished, this, &XMLConfigWriter::finishWrite);
 }
 
 XMLConfigWriter::~XMLConfigWriter()
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
-    if (configFile != nullptr)
-    {
-        if (configFile->isOpen())
-            configFile->close();
-
-        delete configFile;
-        configFile = nullptr;
-    }
+    waitForWrite();
 
     if (xml != nullptr)
     {
@@ -62,41 +60,108 @@ XMLConfigWriter::~XMLConfigWriter()
     }
 }
 
+/**
+ * @brief Serialise the profile into memory and write it to the profile
+ *     file in the background. Only the serialisation reads the device, so
+ *     the caller is blocked just for that part. The file is replaced
+ *     atomically once the data is on disk. Failures are reported with
+ *     writeFailed and every write ends with writeFinished.
+ * @param Profile to write
+ */
 void XMLConfigWriter::write(InputDeviceXml *joystickXml)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
+    // The running write holds a copy of the buffer. Wait for it so the
+    // buffer can be reused and writes to one file stay in order. Its
+    // failure has been reported with writeFailed by then.
+    waitForWrite();
+
     writerError = false;
+    writerErrorString = QString();
+
+    buffer.resize(0);
+
+    QBuffer bufferDevice(&buffer);
+    bufferDevice.open(QIODevice::WriteOnly);
+    xml->setDevice(&bufferDevice);
+
+    xml->writeStartDocument();
+    joystickXml->writeConfig(xml);
+    xml->writeEndDocument();
 
-    if (!configFile->isOpen())
+    xml->setDevice(nullptr);
+    bufferDevice.close();
+
+    writePending = true;
+    writingFileName = fileName;
+    fileWatcher.setFuture(QtConcurrent::run(&XMLConfigWriter::commitToFile, fileName, buffer));
+}
+
+/**
+ * @brief Block until the last profile write has finished.
+ */
+void XMLConfigWriter::waitForWrite()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    if (writePending)
     {
-        configFile->open(QFile::WriteOnly | QFile::Text);
-        xml->setDevice(configFile);
+        fileWatcher.waitForFinished();
+        finishWrite();
     }
-    else
+}
+
+void XMLConfigWriter::finishWrite()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    // Already handled by waitForWrite
+    if (!writePending)
+        return;
+
+    writePending = false;
+    QString errorString = fileWatcher.result();
+
+    if (!errorString.isEmpty())
     {
         writerError = true;
-        writerErrorString = tr("Could not write to profile at %1.").arg(configFile->fileName());
+        writerErrorString = errorString;
+        emit writeFailed(errorString);
     }
 
-    if (!writerError)
+    emit writeFinished(writingFileName, errorString.isEmpty());
+}
+
+/**
+ * @brief Write data into a temporary file next to the profile, flush it to
+ *     disk and rename it over the profile. Runs in a pool thread.
+ * @return Error message or an empty string on success
+ */
+QString XMLConfigWriter::commitToFile(QString fileName, QByteArray data)
+{
+    QSaveFile saveFile(fileName);
+
+    if (!saveFile.open(QIODevice::WriteOnly))
+        return tr("Could not write to profile at %1.").arg(fileName);
+
+    if (saveFile.write(data) != data.size())
     {
-        xml->writeStartDocument();
-        joystickXml->writeConfig(xml);
-        xml->writeEndDocument();
+        saveFile.cancelWriting();
+        return tr("Could not write to profile at %1.").arg(fileName);
     }
 
-    if (configFile->isOpen())
-        configFile->close();
+    if (!saveFile.commit())
+        return tr("Could not write to profile at %1.").arg(fileName);
+
+    return QString();
 }
 
 void XMLConfigWriter::setFileName(QString filename)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
-    QFile *temp = new QFile(filename);
     fileName = filename;
-    configFile = temp;
 }
 
 bool XMLConfigWriter::hasError()
@@ -123,11 +188,6 @@ QString const& XMLConfigWriter::getFileName() {
     return fileName;
 }
 
-const QFile *XMLConfigWriter::getConfigFile() {
-
-    return configFile;
-}
-
 const InputDevice* XMLConfigWriter::getJoystick() {
 
     return m_joystick;
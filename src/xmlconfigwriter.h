@@ -21,36 +21,57 @@
 #define XMLCONFIGWRITER_H
 
 #include <QObject>
+#include <QByteArray>
+#include <QFutureWatcher>
 
 
 class InputDevice;
 class QXmlStreamWriter;
 class InputDeviceXml;
-class QFile;
 
 class XMLConfigWriter : public QObject
 {
     Q_OBJECT
 
 public:
+    // Initial buffer size. Most profiles fit without growing it.
+    static const int INITIALBUFFERSIZE = 64 * 1024;
+
     explicit XMLConfigWriter(QObject *parent = nullptr);
     ~XMLConfigWriter();
     void setFileName(QString filename);
+    // State of the last finished write. Only valid in the thread of the
+    // writer; other threads get failures through writeFailed.
     bool hasError();
     const QString getErrorString();
 
     const QXmlStreamWriter *getXml();
     QString const& getFileName();
-    const QFile *getConfigFile();
     const InputDevice* getJoystick();
+
+    void waitForWrite();
     
+signals:
+    void writeFailed(QString errorString);
+    void writeFinished(QString fileName, bool success);
+
 public slots:
     void write(InputDeviceXml *joystickXml);
 
+private slots:
+    void finishWrite();
+
 private:
+    static QString commitToFile(QString fileName, QByteArray data);
+
     QXmlStreamWriter *xml;
     QString fileName;
-    QFile *configFile;
+    // Serialised profile. Reused between writes to avoid reallocating.
+    QByteArray buffer;
+    QFutureWatcher<QString> fileWatcher;
+    bool writePending;
+    // Profile the running write replaces
+    QString writingFileName;
     InputDevice* m_joystick;
     InputDeviceXml* m_joystickXml;
     bool writerError;
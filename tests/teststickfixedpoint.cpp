@@ -0,0 +1,211 @@
+#include "stickfixedpoint.h"
+
+#include <QtTest/QtTest>
+
+#include <cmath>
+#include <random>
+
+/*
+Compares StickFixedPoint with the floating point formulas of JoyControlStick
+that it replaces. The reference functions below are copies of the code in
+joycontrolstick.cpp built without WITH_FIXED_POINT_STICK.
+*/
+
+static const int POSITIONS = 1000000;
+static const double PI = acos(-1.0);
+
+// Rounding of the result and of the circle adjustment, one Q16.16 step each
+static const double DISTANCETOLERANCE = 2.0 / StickFixedPoint::ONE;
+static const double BEARINGTOLERANCE = 2e-4;
+
+static double referenceBearing(int axisXValue, int axisYValue)
+{
+    if ((axisXValue == 0) && (axisYValue == 0))
+        return 0.0;
+
+    double angle = (atan2(axisXValue, -axisYValue) * 180) / PI;
+
+    return (axisXValue >= 0) ? angle : 360.0 + angle;
+}
+
+static double referenceCircleStickFull(int axisXValue, int axisYValue, double circle)
+{
+    double angle2 = atan2(axisXValue, -axisYValue);
+    double ang_sin = sin(angle2);
+    double ang_cos = cos(angle2);
+
+    double squareStickFullPhi = qMin((ang_sin != 0.0) ? 1/fabs(ang_sin) : 2, ang_cos != 0.0 ? 1/fabs(ang_cos) : 2);
+    return (squareStickFullPhi - 1) * circle + 1;
+}
+
+static double referenceDistanceFromDeadZone(int axisXValue, int axisYValue, int deadZone, int maxZone, double circle)
+{
+    int squared_dist = (axisXValue * axisXValue) + (axisYValue * axisYValue);
+    int dist = sqrt(squared_dist);
+
+    double circleStickFull = referenceCircleStickFull(axisXValue, axisYValue, circle);
+    double adjustedDist = (circleStickFull > 1.0) ? (dist / circleStickFull) : dist;
+    double adjustedDeadZone = (circleStickFull > 1.0) ? (deadZone / circleStickFull) : deadZone;
+
+    double distance = (adjustedDist - adjustedDeadZone)/(static_cast<double>(maxZone) - adjustedDeadZone);
+    return qBound(0.0, distance, 1.0);
+}
+
+static double referenceAxisDistanceFromDeadZone(int axisXValue, int axisYValue, bool yAxis,
+                                              int deadZone, int maxZone, double circle)
+{
+    double angle2 = atan2(axisXValue, -axisYValue);
+    int deadAxis = abs(floor(deadZone * (yAxis ? cos(angle2) : sin(angle2)) + 0.5));
+    int axisValue = yAxis ? axisYValue : axisXValue;
+
+    double circleStickFull = referenceCircleStickFull(axisXValue, axisYValue, circle);
+    double adjustedAxisValue = (circleStickFull > 1.0) ? (axisValue / circleStickFull) : axisValue;
+    double adjustedDeadZone = (circleStickFull > 1.0) ? (deadAxis / circleStickFull) : deadAxis;
+
+    double maxRange = static_cast<double>(maxZone) - adjustedDeadZone;
+    double distance = 0.0;
+
+    if (maxRange != 0.0)
+        distance = (fabs(adjustedAxisValue) - adjustedDeadZone) / maxRange;
+
+    return qBound(0.0, distance, 1.0);
+}
+
+static double referenceRadialDistance(int axisXValue, int axisYValue, int maxZone)
+{
+    int square_dist = (axisXValue * axisXValue) + (axisYValue * axisYValue);
+    double distance = sqrt(square_dist)/static_cast<double>(maxZone);
+
+    return qBound(0.0, distance, 1.0);
+}
+
+class TestStickFixedPoint: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestStickFixedPoint(QObject* parent = 0);
+
+private slots:
+    void bearingMatchesFloatingPoint();
+    void distanceFromDeadZoneMatchesFloatingPoint();
+    void axisDistanceFromDeadZoneMatchesFloatingPoint();
+    void radialDistanceMatchesFloatingPoint();
+
+private:
+    int randomAxisValue();
+    double randomCircle();
+    void randomZones(int &deadZone, int &maxZone);
+
+    std::mt19937 generator;
+};
+
+TestStickFixedPoint::TestStickFixedPoint(QObject* parent) :
+    QObject(parent),
+    generator(0x5714C)
+{
+}
+
+int TestStickFixedPoint::randomAxisValue()
+{
+    return std::uniform_int_distribution<int>(-32767, 32767)(generator);
+}
+
+double TestStickFixedPoint::randomCircle()
+{
+    // The stick edit dialog sets the circle adjustment in steps of 0.01.
+    // Rounding it to Q16.16 is part of the input, not of the calculation.
+    double circle = std::uniform_int_distribution<int>(0, 100)(generator) / 100.0;
+    return StickFixedPoint::toDouble(StickFixedPoint::fromDouble(circle));
+}
+
+void TestStickFixedPoint::randomZones(int &deadZone, int &maxZone)
+{
+    deadZone = std::uniform_int_distribution<int>(0, 32000)(generator);
+    maxZone = std::uniform_int_distribution<int>(deadZone + 1, 32767)(generator);
+}
+
+void TestStickFixedPoint::bearingMatchesFloatingPoint()
+{
+    for (int i = 0; i < POSITIONS; i++)
+    {
+        int axisXValue = randomAxisValue();
+        int axisYValue = randomAxisValue();
+
+        double difference = fabs(StickFixedPoint::toDouble(StickFixedPoint::bearing(axisXValue, axisYValue))
+                                 - referenceBearing(axisXValue, axisYValue));
+
+        // Both ends of the range describe straight up
+        difference = qMin(difference, 360.0 - difference);
+
+        if (difference > BEARINGTOLERANCE)
+            QFAIL(qPrintable(QString("Bearing of %1,%2 is off by %3").arg(axisXValue).arg(axisYValue).arg(difference)));
+    }
+}
+
+void TestStickFixedPoint::distanceFromDeadZoneMatchesFloatingPoint()
+{
+    for (int i = 0; i < POSITIONS; i++)
+    {
+        int axisXValue = randomAxisValue();
+        int axisYValue = randomAxisValue();
+        int deadZone = 0;
+        int maxZone = 0;
+        randomZones(deadZone, maxZone);
+        double circle = randomCircle();
+
+        double difference = fabs(StickFixedPoint::toDouble(StickFixedPoint::distanceFromDeadZone(axisXValue, axisYValue, deadZone,
+                                                                                                 maxZone, StickFixedPoint::fromDouble(circle)))
+                                 - referenceDistanceFromDeadZone(axisXValue, axisYValue, deadZone, maxZone, circle));
+
+        if (difference > DISTANCETOLERANCE)
+            QFAIL(qPrintable(QString("Distance of %1,%2 is off by %3").arg(axisXValue).arg(axisYValue).arg(difference)));
+    }
+}
+
+void TestStickFixedPoint::axisDistanceFromDeadZoneMatchesFloatingPoint()
+{
+    for (int i = 0; i < POSITIONS; i++)
+    {
+        int axisXValue = randomAxisValue();
+        int axisYValue = randomAxisValue();
+        int deadZone = 0;
+        int maxZone = 0;
+        randomZones(deadZone, maxZone);
+        double circle = randomCircle();
+        StickFixedPoint::fixed fixedCircle = StickFixedPoint::fromDouble(circle);
+
+        double differenceX = fabs(StickFixedPoint::toDouble(StickFixedPoint::axisDistanceFromDeadZone(axisXValue, axisXValue, axisYValue,
+                                                                                                      deadZone, maxZone, fixedCircle))
+                                  - referenceAxisDistanceFromDeadZone(axisXValue, axisYValue, false, deadZone, maxZone, circle));
+
+        double differenceY = fabs(StickFixedPoint::toDouble(StickFixedPoint::axisDistanceFromDeadZone(-axisYValue, axisXValue, axisYValue,
+                                                                                                      deadZone, maxZone, fixedCircle))
+                                  - referenceAxisDistanceFromDeadZone(axisXValue, axisYValue, true, deadZone, maxZone, circle));
+
+        if (differenceX > DISTANCETOLERANCE)
+            QFAIL(qPrintable(QString("X distance of %1,%2 is off by %3").arg(axisXValue).arg(axisYValue).arg(differenceX)));
+
+        if (differenceY > DISTANCETOLERANCE)
+            QFAIL(qPrintable(QString("Y distance of %1,%2 is off by %3").arg(axisXValue).arg(axisYValue).arg(differenceY)));
+    }
+}
+
+void TestStickFixedPoint::radialDistanceMatchesFloatingPoint()
+{
+    for (int i = 0; i < POSITIONS; i++)
+    {
+        int axisXValue = randomAxisValue();
+        int axisYValue = randomAxisValue();
+        int maxZone = std::uniform_int_distribution<int>(1, 32767)(generator);
+
+        double difference = fabs(StickFixedPoint::toDouble(StickFixedPoint::radialDistance(axisXValue, axisYValue, maxZone))
+                                 - referenceRadialDistance(axisXValue, axisYValue, maxZone));
+
+        if (difference > DISTANCETOLERANCE)
+            QFAIL(qPrintable(QString("Radial distance of %1,%2 is off by %3").arg(axisXValue).arg(axisYValue).arg(difference)));
+    }
+}
+
+QTEST_APPLESS_MAIN(TestStickFixedPoint)
+#include "teststickfixedpoint.moc"